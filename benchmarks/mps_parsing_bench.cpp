@@ -0,0 +1,196 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// MPS parsing throughput on a synthetic enlargement of ramos3: the COLUMNS section is replicated
+// `scale` times under different column names, so rows (and ridx_t) stay the same while columns and
+// nonzeros grow linearly. The current parser is compared against the previous split() +
+// std::unordered_map<std::string> implementation, reported as "legacy".
+// Usage: mps_parsing_bench [scale] [repetitions]
+
+#include <fmt/core.h>
+#include <fmt/ostream.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/Instance.hpp"
+#include "core/cft.hpp"
+#include "core/parsing.hpp"
+#include "utils/Chrono.hpp"
+#include "utils/parse_utils.hpp"
+
+#ifndef CFT_INSTANCES_DIR
+#define CFT_INSTANCES_DIR "instances"
+#endif
+
+// Global allocation counter, to check that parsing does not allocate per line
+static size_t num_allocs = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void* operator new(size_t size) {
+    ++num_allocs;
+    if (void* ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+    std::free(ptr);
+}
+
+namespace cft {
+namespace local { namespace {
+
+    // Previous implementation, kept here as a reference
+    Instance legacy_parse_mps_instance(std::string const& path) {
+        auto file_iter = FileLineIterator(path);
+        auto inst      = Instance();
+
+        auto line_view = file_iter.next();
+        while (line_view != "ROWS")
+            line_view = file_iter.next();
+
+        ridx_t nrows    = 0_R;
+        auto   rows_map = std::unordered_map<std::string, ridx_t>();
+        auto   obj_name = std::string();
+        while (line_view != "COLUMNS") {
+            auto tokens = split(line_view);
+            if (!tokens.empty() && tokens[0] == "N")
+                obj_name = tokens[1].to_cpp_string();
+            if (!tokens.empty() && (tokens[0] == "G" || tokens[0] == "E" || tokens[0] == "L"))
+                rows_map[tokens[1].to_cpp_string()] = nrows++;
+            line_view = file_iter.next();
+        }
+
+        auto prev_col_name = std::string();
+        line_view          = file_iter.next();
+        inst.cols.begs.clear();
+        while (line_view != "RHS") {
+            auto tokens = split(line_view);
+            if (tokens.size() < 3 || (std::isdigit(tokens[2][0]) == 0 && tokens[2][0] != '-')) {
+                line_view = file_iter.next();
+                continue;
+            }
+            if (tokens[0] != prev_col_name) {
+                prev_col_name = tokens[0].to_cpp_string();
+                inst.cols.begs.push_back(csize(inst.cols.idxs));
+                inst.costs.push_back(limits<real_t>::max());
+            }
+            for (size_t t = 1; t < tokens.size(); t += 2) {
+                if (tokens[t] == obj_name)
+                    inst.costs.back() = string_to<real_t>::parse(tokens[t + 1]);
+                else
+                    inst.cols.idxs.push_back(rows_map[tokens[t].to_cpp_string()]);
+            }
+            line_view = file_iter.next();
+        }
+        inst.cols.begs.push_back(csize(inst.cols.idxs));
+        fill_rows_from_cols(inst.cols, nrows, inst.rows);
+        return inst;
+    }
+
+    // Writes a copy of src_path with the COLUMNS section replicated scale times
+    size_t write_scaled_mps(std::string const& src_path,
+                            std::string const& dst_path,
+                            size_t             scale) {
+        auto in    = std::ifstream(src_path);
+        auto lines = std::vector<std::string>();
+        for (auto line = std::string(); std::getline(in, line);)
+            lines.push_back(line);
+        if (lines.empty())
+            throw std::runtime_error("Cannot read " + src_path);
+
+        size_t cols_beg = 0;
+        size_t rhs_beg  = 0;
+        for (size_t l = 0; l < lines.size(); ++l) {
+            if (trim(lines[l]) == "COLUMNS")
+                cols_beg = l + 1;
+            if (trim(lines[l]) == "RHS")
+                rhs_beg = l;
+        }
+
+        auto out = std::ofstream(dst_path);
+        for (size_t l = 0; l < cols_beg; ++l)
+            fmt::print(out, "{}\n", lines[l]);
+        for (size_t c = 0; c < scale; ++c)
+            for (size_t l = cols_beg; l < rhs_beg; ++l) {
+                auto line = StringView(lines[l]);
+                auto name = consume_token(line);
+                fmt::print(out, "    {}_{} {}\n", name.to_cpp_string(), c, line.to_cpp_string());
+            }
+        for (size_t l = rhs_beg; l < lines.size(); ++l)
+            fmt::print(out, "{}\n", lines[l]);
+        return static_cast<size_t>(out.tellp());
+    }
+
+    struct BenchResult {
+        double   best_ms = limits<double>::inf();
+        size_t   allocs  = 0;
+        Instance inst;
+    };
+
+    template <typename ParseFn>
+    BenchResult run_bench(uint64_t reps, ParseFn parse) {
+        auto res = BenchResult();
+        for (uint64_t r = 0; r < reps; ++r) {
+            res.inst     = Instance();
+            size_t start = num_allocs;
+            auto   timer = Chrono<>();
+            res.inst     = parse();
+            res.best_ms  = cft::min(res.best_ms, timer.elapsed<msec>());
+            res.allocs   = num_allocs - start;
+        }
+        return res;
+    }
+}  // namespace
+}  // namespace local
+}  // namespace cft
+
+int main(int argc, char const** argv) {
+    using namespace cft;
+
+    uint64_t scale = argc > 1 ? string_to<uint64_t>::parse(argv[1]) : 20;
+    uint64_t reps  = argc > 2 ? string_to<uint64_t>::parse(argv[2]) : 5;
+    auto     path  = std::string("ramos3_x") + std::to_string(scale) + ".mps";
+    size_t   bytes = local::write_scaled_mps(
+        std::string(CFT_INSTANCES_DIR) + "/mps/ramos3.mps", path, scale);
+
+    auto legacy = local::run_bench(reps, [&] { return local::legacy_parse_mps_instance(path); });
+    auto stream = local::run_bench(reps, [&] { return parse_mps_instance(path); });
+    auto mapped = local::run_bench(reps, [&] { return parse_mps_instance(path, MmapParsing{}); });
+    std::remove(path.c_str());
+
+    auto nnz = size(stream.inst.cols.idxs);
+    fmt::print("ramos3 x{}: {} rows, {} cols, {} nnz, {:.1f} MB\n",
+               scale,
+               size(stream.inst.rows),
+               size(stream.inst.cols),
+               nnz,
+               static_cast<double>(bytes) / 1e6);
+    fmt::print(
+        "{:10} {:>10} {:>10} {:>12} {:>12}\n", "Mode", "Time(ms)", "MB/s", "Mnnz/s", "Allocs");
+    auto print_row = [&](char const* name, local::BenchResult const& res) {
+        fmt::print("{:10} {:>10.2f} {:>10.1f} {:>12.2f} {:>12}\n",
+                   name,
+                   res.best_ms,
+                   static_cast<double>(bytes) / 1e3 / res.best_ms,
+                   static_cast<double>(nnz) / 1e3 / res.best_ms,
+                   res.allocs);
+    };
+    print_row("legacy", legacy);
+    print_row("stream", stream);
+    print_row("mmap", mapped);
+
+    if (legacy.inst.cols.idxs != stream.inst.cols.idxs || legacy.inst.costs != stream.inst.costs ||
+        stream.inst.cols.idxs != mapped.inst.cols.idxs || stream.inst.costs != mapped.inst.costs)
+        fmt::print("WARNING: parsers disagree\n");
+    return EXIT_SUCCESS;
+}
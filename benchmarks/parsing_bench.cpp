@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Compares the stream-based, memory-mapped and parallel parsing modes on the bundled instances.
+// Usage: parsing_bench [repetitions] [nthreads]
+
+#include <fmt/core.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/Instance.hpp"
+#include "core/cft.hpp"
+#include "core/parsing.hpp"
+#include "utils/Chrono.hpp"
+#include "utils/parse_utils.hpp"
+
+#ifndef CFT_INSTANCES_DIR
+#define CFT_INSTANCES_DIR "instances"
+#endif
+
+namespace cft {
+namespace local { namespace {
+    struct BenchInstance {
+        std::string parser;
+        std::string path;
+    };
+
+    template <typename ModeT>
+    Instance parse_with(BenchInstance const& bi, ModeT mode) {
+        if (bi.parser == CFT_SCP_PARSER)
+            return parse_scp_instance(bi.path, mode);
+        if (bi.parser == CFT_RAIL_PARSER)
+            return parse_rail_instance(bi.path, mode);
+        return parse_cvrp_instance(bi.path, mode).inst;
+    }
+
+    // SCP files are row-major, there is no parallel mode for them
+    Instance parse_with(BenchInstance const& bi, ParallelParsing mode) {
+        if (bi.parser == CFT_RAIL_PARSER)
+            return parse_rail_instance(bi.path, mode);
+        if (bi.parser == CFT_CVRP_PARSER)
+            return parse_cvrp_instance(bi.path, mode).inst;
+        return parse_scp_instance(bi.path, MmapParsing{});
+    }
+
+    // Best time over the given repetitions, in milliseconds
+    template <typename ModeT>
+    double best_parsing_time(BenchInstance const& bi, ModeT mode, uint64_t reps, Instance& inst) {
+        double best = limits<double>::inf();
+        for (uint64_t r = 0; r < reps; ++r) {
+            auto timer = Chrono<>();
+            inst       = parse_with(bi, mode);
+            best       = cft::min(best, timer.elapsed<msec>());
+        }
+        return best;
+    }
+
+    bool same_instance(Instance const& a, Instance const& b) {
+        return a.cols.idxs == b.cols.idxs && a.cols.begs == b.cols.begs && a.costs == b.costs &&
+               a.rows == b.rows;
+    }
+}  // namespace
+}  // namespace local
+}  // namespace cft
+
+int main(int argc, char const** argv) {
+    using namespace cft;
+
+    uint64_t reps        = argc > 1 ? string_to<uint64_t>::parse(argv[1]) : 5;
+    uint64_t nthreads    = argc > 2 ? string_to<uint64_t>::parse(argv[2])
+                                    : cft::max(std::thread::hardware_concurrency(), 1U);
+    auto     dir         = std::string(CFT_INSTANCES_DIR);
+    auto     bench_insts = std::vector<local::BenchInstance>{
+        {CFT_SCP_PARSER, dir + "/scp/scp41.txt"},
+        {CFT_SCP_PARSER, dir + "/scp/scpnrh5.txt"},
+        {CFT_RAIL_PARSER, dir + "/rail/rail507"},
+        {CFT_RAIL_PARSER, dir + "/rail/rail516"},
+        {CFT_RAIL_PARSER, dir + "/rail/rail582"},
+        {CFT_CVRP_PARSER, dir + "/cvrp/X-n469-k138_z223666_cplex223591.scp"},
+        {CFT_CVRP_PARSER, dir + "/cvrp/X-n573-k30_z51112_cplex51109.scp"},
+        {CFT_CVRP_PARSER, dir + "/cvrp/X-n819-k171_z159584_cplex159577.scp"}};
+
+    fmt::print("Parallel mode with {} threads.\n", nthreads);
+    fmt::print("{:45} {:>10} {:>12} {:>12} {:>12} {:>8} {:>8}\n",
+               "Instance",
+               "Nnz",
+               "Stream(ms)",
+               "Mmap(ms)",
+               "Par(ms)",
+               "Mmap x",
+               "Par x");
+    for (auto const& bi : bench_insts) {
+        auto stream_inst = Instance();
+        auto mmap_inst   = Instance();
+        auto par_inst    = Instance();
+        try {
+            double stream_time = local::best_parsing_time(bi, StreamParsing{}, reps, stream_inst);
+            double mmap_time   = local::best_parsing_time(bi, MmapParsing{}, reps, mmap_inst);
+            double par_time    = local::best_parsing_time(
+                bi, ParallelParsing(nthreads), reps, par_inst);
+            if (!local::same_instance(stream_inst, mmap_inst) ||
+                !local::same_instance(stream_inst, par_inst))
+                fmt::print("WARNING: parsing modes disagree on {}\n", bi.path);
+
+            auto name = bi.path.substr(dir.size() + 1);
+            fmt::print("{:45} {:>10} {:>12.2f} {:>12.2f} {:>12.2f} {:>7.2f}x {:>7.2f}x\n",
+                       name,
+                       size(stream_inst.cols.idxs),
+                       stream_time,
+                       mmap_time,
+                       par_time,
+                       stream_time / mmap_time,
+                       stream_time / par_time);
+        } catch (std::exception const& e) {
+            fmt::print("Skipping {}: {}\n", bi.path, e.what());
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Times the row-oriented hot spots (rows construction, pricing and greedy) on the bundled
+// instances, using the same initial multipliers of the 3-phase.
+// Usage: pricing_bench [repetitions] [nthreads]
+
+#include <fmt/core.h>
+
+#include <string>
+#include <vector>
+
+#include "core/Instance.hpp"
+#include "core/cft.hpp"
+#include "core/parsing.hpp"
+#include "core/utils.hpp"
+#include "greedy/Greedy.hpp"
+#include "subgradient/Pricer.hpp"
+#include "utils/Chrono.hpp"
+#include "utils/parse_utils.hpp"
+
+#ifndef CFT_INSTANCES_DIR
+#define CFT_INSTANCES_DIR "instances"
+#endif
+
+namespace cft {
+namespace local { namespace {
+    struct BenchInstance {
+        std::string parser;
+        std::string path;
+    };
+
+    Instance parse_bench_instance(BenchInstance const& bi) {
+        if (bi.parser == CFT_SCP_PARSER)
+            return parse_scp_instance(bi.path, MmapParsing{});
+        if (bi.parser == CFT_RAIL_PARSER)
+            return parse_rail_instance(bi.path, MmapParsing{});
+        return parse_cvrp_instance(bi.path, MmapParsing{}).inst;
+    }
+
+    // u_i = min_{j in row i} c_j / |col_j|, as in the 3-phase initialization
+    std::vector<real_t> greedy_multipliers(Instance const& inst) {
+        auto lagr_mult = std::vector<real_t>(rsize(inst.rows), limits<real_t>::max());
+        for (cidx_t j = 0_C; j < csize(inst.cols); ++j) {
+            real_t candidate = inst.costs[j] / as_real(size(inst.cols[j]));
+            for (ridx_t i : inst.cols[j])
+                lagr_mult[i] = cft::min(lagr_mult[i], candidate);
+        }
+        return lagr_mult;
+    }
+
+    // Best time over the given repetitions, in milliseconds
+    template <typename Func>
+    double best_time(uint64_t reps, Func func) {
+        double best = limits<double>::inf();
+        for (uint64_t r = 0; r < reps; ++r) {
+            auto timer = Chrono<>();
+            func();
+            best = cft::min(best, timer.elapsed<msec>());
+        }
+        return best;
+    }
+}  // namespace
+}  // namespace local
+}  // namespace cft
+
+int main(int argc, char const** argv) {
+    using namespace cft;
+
+    uint64_t reps        = argc > 1 ? string_to<uint64_t>::parse(argv[1]) : 5;
+    auto     env         = Environment();
+    env.nthreads         = argc > 2 ? string_to<uint64_t>::parse(argv[2]) : 1;
+    auto     dir         = std::string(CFT_INSTANCES_DIR);
+    auto     bench_insts = std::vector<local::BenchInstance>{
+        {CFT_SCP_PARSER, dir + "/scp/scpnrh5.txt"},
+        {CFT_RAIL_PARSER, dir + "/rail/rail507"},
+        {CFT_RAIL_PARSER, dir + "/rail/rail516"},
+        {CFT_RAIL_PARSER, dir + "/rail/rail582"},
+        {CFT_CVRP_PARSER, dir + "/cvrp/X-n573-k30_z51112_cplex51109.scp"},
+        {CFT_CVRP_PARSER, dir + "/cvrp/X-n819-k171_z159584_cplex159577.scp"}};
+
+    fmt::print("{:45} {:>10} {:>12} {:>12} {:>12} {:>12}\n",
+               "Instance",
+               "Nnz",
+               "Rows(ms)",
+               "Pricing(ms)",
+               "Greedy(ms)",
+               "Sol cost");
+    for (auto const& bi : bench_insts) {
+        try {
+            auto inst      = local::parse_bench_instance(bi);
+            auto lagr_mult = local::greedy_multipliers(inst);
+            auto rows_copy = inst.rows;
+            auto pricer    = Pricer();
+            auto core      = InstAndMap();
+            auto greedy    = Greedy();
+            auto red_costs = std::vector<real_t>();
+            auto sol       = std::vector<cidx_t>();
+            auto sol_cost  = limits<real_t>::max();
+            compute_reduced_costs(inst, lagr_mult, red_costs);
+
+            double rows_time = local::best_time(reps, [&] {
+                fill_rows_from_cols(inst.cols, rsize(inst.rows), rows_copy);
+            });
+            double pricing_time = local::best_time(reps,
+                                                   [&] { pricer(env, inst, lagr_mult, core); });
+            double greedy_time  = local::best_time(reps, [&] {
+                sol.clear();
+                sol_cost = greedy(inst, lagr_mult, red_costs, sol);
+            });
+
+            auto name = bi.path.substr(dir.size() + 1);
+            fmt::print("{:45} {:>10} {:>12.2f} {:>12.2f} {:>12.2f} {:>12.1f}\n",
+                       name,
+                       size(inst.cols.idxs),
+                       rows_time,
+                       pricing_time,
+                       greedy_time,
+                       sol_cost);
+        } catch (std::exception const& e) {
+            fmt::print("Skipping {}: {}\n", bi.path, e.what());
+        }
+    }
+    return EXIT_SUCCESS;
+}
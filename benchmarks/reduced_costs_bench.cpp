@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Reduced-cost kernel on a synthetic rail4284-sized matrix (4284 rows, ~1.09M columns, ~11.3M
+// nonzeros). The compiled kernel (SIMD when built with NATIVE_ARCH) is compared against the plain
+// scalar loop, with and without the lower-bound hook used by the subgradient (both the previous
+// branchy version and the current branchless one).
+// Usage: reduced_costs_bench [repetitions]
+
+#include <fmt/core.h>
+
+#include <string>
+#include <vector>
+
+#include "core/Instance.hpp"
+#include "core/cft.hpp"
+#include "core/utils.hpp"
+#include "utils/Chrono.hpp"
+#include "utils/parse_utils.hpp"
+#include "utils/random.hpp"
+
+namespace cft {
+namespace local { namespace {
+    Instance make_rail4284_like(prng_t& rnd) {
+        ridx_t const nrows = 4284_R;
+        cidx_t const ncols = 1092610_C;
+
+        auto inst = Instance();
+        auto col  = std::vector<ridx_t>();
+        for (cidx_t j = 0_C; j < ncols; ++j) {
+            col.clear();
+            size_t col_size = roll_dice(rnd, 1ULL, 20ULL);  // ~10.5 nonzeros on average
+            for (size_t n = 0; n < col_size; ++n)
+                col.push_back(roll_dice(rnd, 0_R, as_ridx(nrows - 1_R)));
+            inst.cols.push_back(col);
+            inst.costs.push_back(as_real(roll_dice(rnd, 1, 3)));
+        }
+        fill_rows_from_cols(inst.cols, nrows, inst.rows);
+        return inst;
+    }
+
+    // Reference implementation: one scalar gather per nonzero
+    void scalar_reduced_costs(Instance const&            inst,
+                              std::vector<real_t> const& multipliers,
+                              std::vector<real_t>&       reduced_costs) {
+        reduced_costs.resize(inst.costs.size());
+        for (cidx_t j = 0_C; j < csize(inst.cols); ++j) {
+            reduced_costs[j] = inst.costs[j];
+            for (ridx_t i : inst.cols[j])
+                reduced_costs[j] -= multipliers[i];
+        }
+    }
+
+    // Best time over the given repetitions, in milliseconds
+    template <typename Func>
+    double best_time(uint64_t reps, Func func) {
+        double best = limits<double>::inf();
+        for (uint64_t r = 0; r < reps; ++r) {
+            auto timer = Chrono<>();
+            func();
+            best = cft::min(best, timer.elapsed<msec>());
+        }
+        return best;
+    }
+}  // namespace
+}  // namespace local
+}  // namespace cft
+
+int main(int argc, char const** argv) {
+    using namespace cft;
+
+    uint64_t reps = argc > 1 ? string_to<uint64_t>::parse(argv[1]) : 10;
+    auto     rnd  = prng_t{0};
+    auto     inst = local::make_rail4284_like(rnd);
+
+    auto lagr_mult = std::vector<real_t>();
+    for (ridx_t i = 0_R; i < rsize(inst.rows); ++i)
+        lagr_mult.push_back(rnd_real(rnd, 0.0_F, 0.5_F));
+
+    auto ref_costs = std::vector<real_t>();
+    auto red_costs = std::vector<real_t>();
+    auto lb_idxs   = std::vector<cidx_t>();
+    real_t lb      = 0.0_F;
+
+    double scalar_time = local::best_time(
+        reps, [&] { local::scalar_reduced_costs(inst, lagr_mult, ref_costs); });
+    double kernel_time = local::best_time(
+        reps, [&] { compute_reduced_costs(inst, lagr_mult, red_costs); });
+    double branchy_time = local::best_time(reps, [&] {
+        lb_idxs.clear();
+        lb = 0.0_F;
+        compute_reduced_costs(inst, lagr_mult, red_costs, [&](real_t red_cost, cidx_t j) {
+            if (red_cost < 0.0_F) {
+                lb_idxs.push_back(j);
+                lb += red_cost;
+            }
+        });
+    });
+    double hook_time = local::best_time(reps, [&] {
+        lb_idxs.resize(inst.cols.size());
+        size_t n = 0;
+        lb       = 0.0_F;
+        compute_reduced_costs(inst, lagr_mult, red_costs, [&](real_t red_cost, cidx_t j) {
+            lb_idxs[n] = j;
+            n += static_cast<size_t>(red_cost < 0.0_F);
+            lb += min(red_cost, 0.0_F);
+        });
+        lb_idxs.resize(n);
+    });
+
+    real_t max_diff = 0.0_F;
+    for (cidx_t j = 0_C; j < csize(inst.cols); ++j)
+        max_diff = max(max_diff, abs(ref_costs[j] - red_costs[j]));
+
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+    auto kernel_name = std::string("simd");
+#else
+    auto kernel_name = std::string("scalar");
+#endif
+    fmt::print("Matrix: {} rows, {} cols, {} nonzeros\n",
+               rsize(inst.rows),
+               csize(inst.cols),
+               inst.cols.idxs.size());
+    fmt::print("Scalar reference:        {:8.2f} ms\n", scalar_time);
+    fmt::print("Kernel ({:6}):         {:8.2f} ms\n", kernel_name, kernel_time);
+    fmt::print("Kernel + branchy hook:   {:8.2f} ms\n", branchy_time);
+    fmt::print("Kernel + lb hook:        {:8.2f} ms ({} negative, LB {:.2f})\n",
+               hook_time,
+               lb_idxs.size(),
+               lb);
+    fmt::print("Max abs difference:      {:.2e}\n", max_diff);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,344 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Runs the complete algorithm on the bundled instance sets for a list of seeds, writing one CSV
+// row per run (cost, lower bound, gap, time, time-to-best and per-component times). The same CSV
+// can be given back as baseline: per-instance averages are compared and the exit code is non-zero
+// if any instance got worse.
+// Usage: solver_bench [--sets scp,rail,mps] [--filter name] [--seeds 1,2,3] [--timelimit sec]
+//                     [--nthreads n] [--out results.csv] [--baseline old.csv]
+//                     [--time-tol rel] [--cost-tol rel]
+
+#include <dirent.h>
+#include <fmt/core.h>
+
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "algorithms/Refinement.hpp"
+#include "core/Profile.hpp"
+#include "core/cft.hpp"
+#include "core/parsing.hpp"
+#include "utils/parse_utils.hpp"
+#include "utils/sort.hpp"
+
+#ifndef CFT_INSTANCES_DIR
+#define CFT_INSTANCES_DIR "instances"
+#endif
+
+namespace cft {
+namespace local { namespace {
+    // Time differences below this many seconds are considered noise
+    constexpr double min_time_delta = 0.05;
+
+    struct BenchSet {
+        char const* name;    // Subfolder of the instances directory
+        char const* parser;  // Parser used for all its instances
+        char const* prefix;  // Instance files start with this prefix...
+        char const* suffix;  // ...and end with this suffix
+    };
+
+    BenchSet const bench_sets[] = {{"scp", CFT_SCP_PARSER, "scp", ".txt"},
+                                   {"rail", CFT_RAIL_PARSER, "rail", ""},
+                                   {"cvrp", CFT_CVRP_PARSER, "", ".scp"},
+                                   {"mps", CFT_MPS_PARSER, "", ".mps"}};
+
+    struct BenchOptions {
+        std::vector<std::string> sets       = {"scp", "rail", "mps"};
+        std::string              filter     = "";
+        std::vector<uint64_t>    seeds      = {1, 2, 3};
+        double                   time_limit = limits<double>::inf();
+        uint64_t                 nthreads   = 1;
+        std::string              out_path   = "solver_bench.csv";
+        std::string              base_path  = "";
+        double                   time_tol   = 0.10;  // Relative slowdown allowed
+        double                   cost_tol   = 0.0;   // Relative cost increase allowed
+    };
+
+    // Per-instance aggregate of a set of runs
+    struct InstStats {
+        uint64_t runs       = 0;
+        double   best_cost  = limits<double>::inf();
+        double   cost_sum   = 0.0;
+        double   gap_sum    = 0.0;
+        double   time_sum   = 0.0;
+        double   time_sqsum = 0.0;
+        double   ttb_sum    = 0.0;
+
+        void add(double cost, double gap, double time, double ttb) {
+            ++runs;
+            best_cost = cft::min(best_cost, cost);
+            cost_sum += cost;
+            gap_sum += gap;
+            time_sum += time;
+            time_sqsum += time * time;
+            ttb_sum += ttb;
+        }
+
+        double avg_cost() const {
+            return cost_sum / static_cast<double>(runs);
+        }
+
+        double avg_time() const {
+            return time_sum / static_cast<double>(runs);
+        }
+
+        // Sample standard deviation of the running time
+        double std_time() const {
+            if (runs < 2)
+                return 0.0;
+            double n   = static_cast<double>(runs);
+            double var = (time_sqsum - time_sum * time_sum / n) / (n - 1.0);
+            return std::sqrt(cft::max(var, 0.0));
+        }
+    };
+
+    using StatsMap = std::map<std::string, InstStats>;
+
+    std::vector<std::string> split_list(std::string const& list) {
+        auto out = std::vector<std::string>();
+        auto beg = size_t{0};
+        while (beg <= list.size()) {
+            size_t end = cft::min(list.find(',', beg), list.size());
+            if (end > beg)
+                out.push_back(list.substr(beg, end - beg));
+            beg = end + 1;
+        }
+        return out;
+    }
+
+    bool has_affixes(std::string const& name, BenchSet const& set) {
+        auto plen = std::string(set.prefix).size();
+        auto slen = std::string(set.suffix).size();
+        return name.size() > plen + slen && name.compare(0, plen, set.prefix) == 0 &&
+               name.compare(name.size() - slen, slen, set.suffix) == 0;
+    }
+
+    // Instance files of a set, sorted by name
+    std::vector<std::string> list_instances(std::string const& dir, BenchSet const& set) {
+        auto names = std::vector<std::string>();
+        DIR* dp    = opendir(dir.c_str());
+        if (dp == nullptr)
+            return names;
+        for (dirent* entry = readdir(dp); entry != nullptr; entry = readdir(dp))
+            if (has_affixes(entry->d_name, set))
+                names.emplace_back(entry->d_name);
+        closedir(dp);
+        cft::sort(names);
+        return names;
+    }
+
+    Instance parse_bench_instance(std::string const& parser, std::string const& path) {
+        if (parser == CFT_SCP_PARSER)
+            return parse_scp_instance(path, MmapParsing{});
+        if (parser == CFT_RAIL_PARSER)
+            return parse_rail_instance(path, MmapParsing{});
+        if (parser == CFT_CVRP_PARSER)
+            return parse_cvrp_instance(path, MmapParsing{}).inst;
+        return parse_mps_instance(path, MmapParsing{});
+    }
+
+    BenchOptions parse_bench_args(int argc, char const** argv) {
+        auto opts = BenchOptions();
+        for (int a = 1; a + 1 < argc; a += 2) {
+            auto arg = std::string(argv[a]);
+            auto val = std::string(argv[a + 1]);
+            if (arg == "--sets")
+                opts.sets = split_list(val);
+            else if (arg == "--filter")
+                opts.filter = val;
+            else if (arg == "--seeds") {
+                opts.seeds.clear();
+                for (auto const& s : split_list(val))
+                    opts.seeds.push_back(string_to<uint64_t>::parse(s));
+            } else if (arg == "--timelimit")
+                opts.time_limit = string_to<double>::parse(val);
+            else if (arg == "--nthreads")
+                opts.nthreads = string_to<uint64_t>::parse(val);
+            else if (arg == "--out")
+                opts.out_path = val;
+            else if (arg == "--baseline")
+                opts.base_path = val;
+            else if (arg == "--time-tol")
+                opts.time_tol = string_to<double>::parse(val);
+            else if (arg == "--cost-tol")
+                opts.cost_tol = string_to<double>::parse(val);
+            else
+                throw std::runtime_error("Unknown argument: " + arg);
+        }
+        if (argc % 2 == 0)
+            throw std::runtime_error(fmt::format("Missing value of argument {}", argv[argc - 1]));
+        return opts;
+    }
+
+    std::string csv_header() {
+        auto header = std::string("instance,seed,cost,lower_bound,gap,time,time_to_best");
+        for_each_profile_entry(Profile{}, [&](char const* name, char const*, ProfileEntry const&) {
+            header += fmt::format(",{}_seconds", name);
+        });
+        return header + "\n";
+    }
+
+    // Reads a CSV written by this benchmark, aggregating its runs per instance
+    StatsMap read_results(std::string const& path) {
+        auto in = std::ifstream(path);
+        if (!in.is_open())
+            throw std::runtime_error("Failed to open file for reading: " + path);
+
+        auto stats = StatsMap();
+        auto line  = std::string();
+        std::getline(in, line);  // Header
+        while (std::getline(in, line)) {
+            auto fields = split_list(line);
+            if (fields.size() < 7)
+                continue;
+            stats[fields[0]].add(string_to<double>::parse(fields[2]),
+                                 string_to<double>::parse(fields[4]),
+                                 string_to<double>::parse(fields[5]),
+                                 string_to<double>::parse(fields[6]));
+        }
+        return stats;
+    }
+
+    // Prints the per-instance summary and returns the number of regressions w.r.t. the baseline
+    size_t print_summary(BenchOptions const& opts, StatsMap const& stats, StatsMap const& base) {
+        fmt::print("\n{:32} {:>5} {:>10} {:>10} {:>8} {:>9} {:>8} {:>9} {:>10} {:>10}\n",
+                   "Instance",
+                   "Runs",
+                   "Best Sol",
+                   "Avg Sol",
+                   "Gap(%)",
+                   "Time(s)",
+                   "Std(s)",
+                   "TTB(s)",
+                   "dSol(%)",
+                   "dTime(%)");
+
+        size_t nregressions = 0;
+        for (auto const& kv : stats) {
+            InstStats const& s = kv.second;
+            double const     n = static_cast<double>(s.runs);
+            fmt::print("{:32} {:>5} {:>10.2f} {:>10.2f} {:>8.2f} {:>9.2f} {:>8.2f} {:>9.2f}",
+                       kv.first,
+                       s.runs,
+                       s.best_cost,
+                       s.avg_cost(),
+                       100.0 * s.gap_sum / n,
+                       s.avg_time(),
+                       s.std_time(),
+                       s.ttb_sum / n);
+
+            auto it = base.find(kv.first);
+            if (it == base.end()) {
+                fmt::print("\n");
+                continue;
+            }
+            InstStats const& b         = it->second;
+            double const     cost_diff = s.avg_cost() - b.avg_cost();
+            double const     time_diff = s.avg_time() - b.avg_time();
+            bool const       cost_regr = cost_diff > opts.cost_tol * b.avg_cost() + 1e-6;
+            bool const       time_regr = time_diff >
+                                   cft::max(opts.time_tol * b.avg_time(), min_time_delta);
+            fmt::print(" {:>10.2f} {:>10.2f}{}\n",
+                       100.0 * cost_diff / b.avg_cost(),
+                       100.0 * time_diff / cft::max(b.avg_time(), 1e-9),
+                       cost_regr || time_regr ? "  <-- REGRESSION" : "");
+            nregressions += cost_regr || time_regr ? 1 : 0;
+        }
+        return nregressions;
+    }
+}  // namespace
+}  // namespace local
+}  // namespace cft
+
+namespace {
+int bench_main(int argc, char const** argv) {
+    using namespace cft;
+
+    auto opts = local::parse_bench_args(argc, argv);
+    auto base = opts.base_path.empty() ? local::StatsMap() : local::read_results(opts.base_path);
+    auto dir  = std::string(CFT_INSTANCES_DIR);
+    auto out  = std::ofstream(opts.out_path);
+    if (!out.is_open())
+        throw std::runtime_error("Failed to open file for writing: " + opts.out_path);
+    out << local::csv_header();
+
+    auto stats = local::StatsMap();
+    for (auto const& set : local::bench_sets) {
+        if (!any(opts.sets, [&](std::string const& s) { return s == set.name; }))
+            continue;
+
+        auto set_dir = dir + "/" + set.name;
+        for (auto const& file : local::list_instances(set_dir, set)) {
+            auto name = std::string(set.name) + "/" + file;
+            if (name.find(opts.filter) == std::string::npos)
+                continue;
+
+            auto inst = Instance();
+            try {
+                inst = local::parse_bench_instance(set.parser, set_dir + "/" + file);
+            } catch (std::exception const& e) {
+                fmt::print("Skipping {}: {}\n", name, e.what());
+                continue;
+            }
+
+            fmt::print("{:32} ", name);
+            for (uint64_t seed : opts.seeds) {
+                auto env       = Environment();
+                env.seed       = seed;
+                env.rnd        = prng_t(seed);
+                env.time_limit = opts.time_limit;
+                env.nthreads   = opts.nthreads;
+                env.verbose    = 0;
+                env.timer      = Chrono<>();
+                auto   res     = run(env, inst);
+                double time    = env.timer.elapsed<sec>();
+                double cost    = static_cast<double>(native_cast(res.sol.cost));
+                double lb      = static_cast<double>(native_cast(res.dual.lb));
+                double gap     = cost > 0.0 ? (cost - lb) / cost : 0.0;
+
+                out << fmt::format("{},{},{:.4f},{:.4f},{:.6f},{:.6f},{:.6f}",
+                                   name,
+                                   seed,
+                                   cost,
+                                   lb,
+                                   gap,
+                                   time,
+                                   res.sol_time);
+                local::for_each_profile_entry(
+                    res.profile, [&](char const*, char const*, ProfileEntry const& entry) {
+                        out << fmt::format(",{:.6f}", entry.seconds);
+                    });
+                out << "\n";
+                stats[name].add(cost, gap, time, res.sol_time);
+                fmt::print(".");
+                std::fflush(stdout);
+            }
+            fmt::print("\n");
+        }
+    }
+    out.flush();
+
+    size_t nregressions = local::print_summary(opts, stats, base);
+    fmt::print("\nResults written to {}\n", opts.out_path);
+    if (!opts.base_path.empty())
+        fmt::print("{} regression(s) w.r.t. {}\n", nregressions, opts.base_path);
+    return nregressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace
+
+int main(int argc, char const** argv) {
+    try {
+        return bench_main(argc, argv);
+    } catch (std::exception const& e) {
+        fmt::print(stderr, "\nsolver_bench: ERROR: {}\n", e.what());
+        std::fflush(stdout);
+        return EXIT_FAILURE;
+    }
+}
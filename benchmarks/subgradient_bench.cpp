@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Row kernels of a subgradient iteration on a synthetic 10k-row matrix: squared norm of the
+// subgradient, multiplier update and sum of the multipliers (the constant term of the lower bound).
+// The previous separate scalar passes are compared against the vectorizable norm and the fused
+// update kernels, both on the row sweep alone and including the scatter of the multiplier changes
+// into the reduced costs.
+// Usage: subgradient_bench [nrows] [ncols] [iterations] [repetitions]
+
+#include <fmt/core.h>
+
+#include <vector>
+
+#include "core/Instance.hpp"
+#include "core/cft.hpp"
+#include "subgradient/utils.hpp"
+#include "utils/Chrono.hpp"
+#include "utils/CoverCounters.hpp"
+#include "utils/parse_utils.hpp"
+#include "utils/random.hpp"
+
+namespace cft {
+namespace local { namespace {
+    Instance make_rail_like_inst(prng_t& rnd, ridx_t nrows, cidx_t ncols) {
+        auto inst = Instance();
+        auto col  = std::vector<ridx_t>();
+        for (cidx_t j = 0_C; j < ncols; ++j) {
+            col.clear();
+            size_t col_size = roll_dice(rnd, 1ULL, 20ULL);
+            for (size_t n = 0; n < col_size; ++n)
+                col.push_back(roll_dice(rnd, 0_R, as_ridx(nrows - 1_R)));
+            inst.cols.push_back(col);
+            inst.costs.push_back(as_real(roll_dice(rnd, 1, 3)));
+        }
+        fill_rows_from_cols(inst.cols, nrows, inst.rows);
+        return inst;
+    }
+
+    // Previous implementation: one scalar pass each for the norm, the update and the sum
+    real_t scalar_sqr_norm(CoverCounters const& row_coverage) {
+        int64_t sqr_norm = 0;
+        for (ridx_t i = 0_R; i < rsize(row_coverage); ++i) {
+            int64_t violation = 1 - checked_cast<int64_t>(row_coverage[i]);
+            sqr_norm += violation * violation;
+        }
+        return as_real(sqr_norm);
+    }
+
+    void scalar_update(Instance const&      inst,
+                       CoverCounters const& row_coverage,
+                       real_t               step_factor,
+                       bool                 scatter,
+                       std::vector<real_t>& lagr_mult,
+                       std::vector<real_t>& reduced_costs) {
+        for (ridx_t i = 0_R; i < rsize(row_coverage); ++i) {
+            auto violation = 1.0_F - as_real(row_coverage[i]);
+            if (violation == 0.0_F)
+                continue;
+            real_t old_mult = lagr_mult[i];
+            lagr_mult[i]    = clamp(old_mult + step_factor * violation, 0.0_F, 1e6_F);
+            real_t applied_delta = lagr_mult[i] - old_mult;
+            if (scatter && applied_delta != 0.0_F)
+                for (cidx_t j : inst.rows[i])
+                    reduced_costs[j] -= applied_delta;
+        }
+    }
+
+    real_t scalar_sum(std::vector<real_t> const& lagr_mult) {
+        real_t sum = 0.0_F;
+        for (real_t const value : lagr_mult)
+            sum += value;
+        return sum;
+    }
+
+    void fused_update(Instance const&      inst,
+                      CoverCounters const& row_coverage,
+                      real_t               step_factor,
+                      bool                 scatter,
+                      std::vector<real_t>& lagr_mult,
+                      std::vector<real_t>& mult_delta,
+                      std::vector<real_t>& reduced_costs,
+                      real_t&              mult_sum) {
+        mult_sum = update_lagr_mult(row_coverage, step_factor, lagr_mult, mult_delta);
+        if (scatter)
+            apply_mult_delta(inst, mult_delta, reduced_costs);
+    }
+
+    // Best time over the given repetitions, in milliseconds
+    template <typename Func>
+    double best_time(uint64_t reps, Func func) {
+        double best = limits<double>::inf();
+        for (uint64_t r = 0; r < reps; ++r) {
+            auto timer = Chrono<>();
+            func();
+            best = cft::min(best, timer.elapsed<msec>());
+        }
+        return best;
+    }
+}  // namespace
+}  // namespace local
+}  // namespace cft
+
+int main(int argc, char const** argv) {
+    using namespace cft;
+
+    auto     nrows = argc > 1 ? string_to<ridx_t>::parse(argv[1]) : 10000_R;
+    auto     ncols = argc > 2 ? string_to<cidx_t>::parse(argv[2]) : 200000_C;
+    uint64_t iters = argc > 3 ? string_to<uint64_t>::parse(argv[3]) : 1000;
+    uint64_t reps  = argc > 4 ? string_to<uint64_t>::parse(argv[4]) : 10;
+
+    auto rnd  = prng_t{0};
+    auto inst = local::make_rail_like_inst(rnd, nrows, ncols);
+
+    // Reduced coverage of about 5% of the columns, as the lower bound solution of the subgradient
+    auto row_coverage = CoverCounters(rsize(inst.rows));
+    for (cidx_t j = 0_C; j < ncols; ++j)
+        if (coin_flip(rnd, 0.05) && !row_coverage.is_redundant_cover(inst.cols[j]))
+            row_coverage.cover(inst.cols[j]);
+
+    auto init_mult = std::vector<real_t>();
+    for (ridx_t i = 0_R; i < nrows; ++i)
+        init_mult.push_back(rnd_real(rnd, 0.0_F, 0.5_F));
+    auto init_costs = inst.costs;
+
+    // Small steps, so that multipliers keep moving across the iterations without diverging
+    real_t const step_factor = 1e-4_F;
+
+    auto   lagr_mult     = std::vector<real_t>();
+    auto   mult_delta    = std::vector<real_t>();
+    auto   reduced_costs = std::vector<real_t>();
+    real_t sqr_norm      = 0.0_F;
+    real_t mult_sum      = 0.0_F;
+
+    auto scalar_iters = [&](bool scatter) {
+        lagr_mult     = init_mult;
+        reduced_costs = init_costs;
+        for (uint64_t it = 0; it < iters; ++it) {
+            mult_sum = local::scalar_sum(lagr_mult);
+            sqr_norm = local::scalar_sqr_norm(row_coverage);
+            local::scalar_update(
+                inst, row_coverage, step_factor, scatter, lagr_mult, reduced_costs);
+        }
+        mult_sum = local::scalar_sum(lagr_mult);
+    };
+    auto fused_iters = [&](bool scatter) {
+        lagr_mult     = init_mult;
+        reduced_costs = init_costs;
+        mult_sum      = local::sum_lagr_mult(lagr_mult);
+        for (uint64_t it = 0; it < iters; ++it) {
+            sqr_norm = local::subgrad_sqr_norm(row_coverage);
+            local::fused_update(inst,
+                                row_coverage,
+                                step_factor,
+                                scatter,
+                                lagr_mult,
+                                mult_delta,
+                                reduced_costs,
+                                mult_sum);
+        }
+    };
+
+    double scalar_rows = local::best_time(reps, [&] { scalar_iters(false); });
+    double fused_rows  = local::best_time(reps, [&] { fused_iters(false); });
+    double scalar_full = local::best_time(reps, [&] { scalar_iters(true); });
+    auto   ref_mult    = lagr_mult;
+    auto   ref_costs   = reduced_costs;
+    real_t ref_sum     = mult_sum;
+    real_t ref_norm    = sqr_norm;
+    double fused_full  = local::best_time(reps, [&] { fused_iters(true); });
+
+    real_t max_diff = 0.0_F;
+    for (ridx_t i = 0_R; i < nrows; ++i)
+        max_diff = max(max_diff, abs(ref_mult[i] - lagr_mult[i]));
+    for (cidx_t j = 0_C; j < ncols; ++j)
+        max_diff = max(max_diff, abs(ref_costs[j] - reduced_costs[j]));
+
+    auto per_iter = [&](double millis) { return 1000.0 * millis / static_cast<double>(iters); };
+    fmt::print("Matrix: {} rows, {} cols, {} nonzeros, squared norm {:.0f}\n",
+               nrows,
+               ncols,
+               inst.cols.idxs.size(),
+               ref_norm);
+    fmt::print("Row sweep:        scalar {:8.2f} us/iter, fused {:8.2f} us/iter ({:.2f}x)\n",
+               per_iter(scalar_rows),
+               per_iter(fused_rows),
+               scalar_rows / fused_rows);
+    fmt::print("Row sweep + red.: scalar {:8.2f} us/iter, fused {:8.2f} us/iter ({:.2f}x)\n",
+               per_iter(scalar_full),
+               per_iter(fused_full),
+               scalar_full / fused_full);
+    fmt::print("Multiplier sum:   scalar {:.4f}, fused {:.4f}\n", ref_sum, mult_sum);
+    fmt::print("Max abs difference:      {:.2e}\n", max_diff);
+    return sqr_norm == ref_norm ? EXIT_SUCCESS : EXIT_FAILURE;
+}
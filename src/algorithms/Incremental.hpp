@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef CFT_SRC_ALGORITHMS_INCREMENTAL_HPP
+#define CFT_SRC_ALGORITHMS_INCREMENTAL_HPP
+
+
+#include <vector>
+
+#include "algorithms/Refinement.hpp"
+#include "core/Instance.hpp"
+#include "core/InstanceDelta.hpp"
+#include "core/cft.hpp"
+#include "core/utils.hpp"
+#include "greedy/Greedy.hpp"
+#include "utils/CoverCounters.hpp"
+
+namespace cft {
+namespace local { namespace {
+    // Completes a partial solution (e.g., one that lost some columns) with the greedy, guided by
+    // the given multipliers.
+    inline void complete_solution(Environment const&         env,        // in
+                                  Instance const&            inst,       // in
+                                  std::vector<real_t> const& lagr_mult,  // in
+                                  Solution&                  sol         // inout
+    ) {
+        ridx_t const nrows   = rsize(inst.rows);
+        auto         cover   = CoverCounters(nrows);
+        ridx_t       covered = 0_R;
+        for (cidx_t j : sol.idxs)
+            covered += as_ridx(cover.cover(inst.cols[j]));
+        if (covered == nrows)
+            return;
+
+        auto reduced_costs = std::vector<real_t>();
+        compute_reduced_costs(inst, lagr_mult, reduced_costs);
+        auto greedy = Greedy();
+        greedy.set_enum_limits(env.enum_vars, env.enum_nodes);
+        greedy(inst, lagr_mult, reduced_costs, sol.idxs);
+
+        sol.cost = 0.0_F;
+        for (cidx_t j : sol.idxs)
+            sol.cost += inst.costs[j];
+    }
+}  // namespace
+}  // namespace local
+
+// Incremental re-solve: applies delta to inst in place (see apply_instance_delta) and runs the
+// algorithm warm started from prev, the result of the previous version of inst. Its solution is
+// remapped (and completed by the greedy if some of its columns were removed) to be the initial
+// incumbent, and its dual state seeds the first subgradient (see run). Indexes of prev that are
+// not valid for the old instance are dropped.
+inline CftResult resolve(Environment const&   env,    // in
+                         Instance&            inst,   // inout
+                         InstanceDelta const& delta,  // in
+                         CftResult const&     prev    // in
+) {
+    auto old2new = std::vector<cidx_t>();
+    apply_instance_delta(delta, inst, old2new);
+
+    auto warm = prev;
+    remap_solution(inst, old2new, warm.sol);
+    remap_dual_state(old2new, warm.dual);
+    if (rsize(warm.dual.mults) == rsize(inst.rows))
+        local::complete_solution(env, inst, warm.dual.mults, warm.sol);
+    else
+        local::complete_solution(env, inst, std::vector<real_t>(rsize(inst.rows), 0.0_F), warm.sol);
+
+    return run(env, inst, warm.sol, warm.dual);
+}
+
+}  // namespace cft
+
+
+#endif /* CFT_SRC_ALGORITHMS_INCREMENTAL_HPP */
@@ -6,10 +6,13 @@
 
 
 #include "algorithms/ThreePhase.hpp"
+#include "core/IncumbentNotifier.hpp"
+#include "core/SharedIncumbent.hpp"
 #include "core/cft.hpp"
 #include "utils/Chrono.hpp"
 #include "utils/CoverCounters.hpp"
 #include "utils/limits.hpp"
+#include "utils/parallel.hpp"
 #include "utils/utility.hpp"
 
 namespace cft {
@@ -32,14 +35,16 @@ namespace local { namespace {
         real_t                   prev_cost    = limits<real_t>::max();
         CoverCounters            row_coverage;
         std::vector<CidxAndCost> gap_contributions;  // Delta values in the paper
+        std::vector<cidx_t>      cols_to_fix;
 
 
     public:
-        // Finds a set of columns to fix in the next refinement iteration.
-        std::vector<cidx_t> operator()(Environment const&         env,             // in
-                                       Instance const&            inst,            // in
-                                       std::vector<real_t> const& best_lagr_mult,  // in
-                                       Solution const&            best_sol         // in
+        // Finds a set of columns to fix in the next refinement iteration. The returned reference is
+        // valid until the next call.
+        std::vector<cidx_t> const& operator()(Environment const&         env,             // in
+                                              Instance const&            inst,            // in
+                                              std::vector<real_t> const& best_lagr_mult,  // in
+                                              Solution const&            best_sol         // in
         ) {
             ridx_t const nrows = rsize(inst.rows);
 
@@ -74,7 +79,7 @@ namespace local { namespace {
 
             ridx_t covered_rows = 0_R;
             row_coverage.reset(nrows);
-            auto cols_to_fix = std::vector<cidx_t>();
+            cols_to_fix.clear();
             for (CidxAndCost c : gap_contributions) {
                 covered_rows += as_ridx(row_coverage.cover(inst.cols[c.idx]));
                 if (covered_rows > nrows_to_fix)
@@ -84,73 +89,164 @@ namespace local { namespace {
             return cols_to_fix;
         }
     };
-}  // namespace
-}  // namespace local
 
-// Complete CFT algorithm (Refinement + call to 3-phase)
-inline CftResult run(Environment const& env,                // in
-                     Instance const&    orig_inst,          // in
-                     Solution const&    warmstart_sol = {}  // in
-) {
-
-    cidx_t const ncols = csize(orig_inst.cols);
-    ridx_t const nrows = rsize(orig_inst.rows);
-
-    auto inst       = orig_inst;
-    auto nofix_dual = DualState();
-    auto best_sol   = Solution();
-    best_sol.cost   = limits<real_t>::max();
-
-    if (!warmstart_sol.idxs.empty())
-        best_sol = warmstart_sol;
-
-    auto three_phase        = ThreePhase();
-    auto select_cols_to_fix = local::RefinementFixManager();
-    auto old2new            = IdxsMaps();
-    auto fixing             = FixingData();
-    auto max_cost           = limits<real_t>::max();
-    make_identity_fixing_data(ncols, nrows, fixing);
-    for (size_t iter_counter = 0;; ++iter_counter) {
-
-        auto result_3p = three_phase(env, inst);
-        if (result_3p.sol.cost + fixing.fixed_cost < best_sol.cost) {
-            local::from_fixed_to_unfixed_sol(result_3p.sol, fixing, best_sol);
-            CFT_IF_DEBUG(check_inst_solution(orig_inst, best_sol));
-        }
+    // Complete CFT algorithm (Refinement + call to 3-phase). If an incumbent is given, it is
+    // shared with other concurrent runs: its cost is used as cutoff, the columns to fix are
+    // selected around it and improvements are published as soon as they are found.
+    inline CftResult run_refinement(Environment const& env,             // in
+                                    Instance const&    orig_inst,       // in
+                                    Solution const&    warmstart_sol,   // in
+                                    DualState const&   warmstart_dual,  // in
+                                    SharedIncumbent*   incumbent        // inout
+    ) {
 
-        if (iter_counter == 0) {
-            nofix_dual = std::move(result_3p.dual);
-            max_cost   = env.beta * nofix_dual.lb + env.epsilon;
-        }
+        cidx_t const ncols = csize(orig_inst.cols);
+        ridx_t const nrows = rsize(orig_inst.rows);
+
+        auto inst       = orig_inst;
+        auto nofix_dual = DualState();
+        auto best_sol   = Solution();
+        auto sol_time   = 0.0;
+        best_sol.cost   = limits<real_t>::max();
+
+        if (!warmstart_sol.idxs.empty())
+            best_sol = warmstart_sol;
+        if (incumbent == nullptr && env.notifier != nullptr && !best_sol.idxs.empty())
+            env.notifier->publish(best_sol);
+
+        auto three_phase        = ThreePhase();
+        auto select_cols_to_fix = RefinementFixManager();
+        auto old2new            = IdxsMaps();
+        auto fixing             = FixingData();
+        auto max_cost           = limits<real_t>::max();
+        make_identity_fixing_data(ncols, nrows, fixing);
+        for (size_t iter_counter = 0;; ++iter_counter) {
+
+            auto const* warm_dual = iter_counter == 0 ? &warmstart_dual : nullptr;
+            auto        result_3p = three_phase(env, inst, incumbent, &fixing, warm_dual);
+            if (result_3p.sol.cost + fixing.fixed_cost < best_sol.cost) {
+                from_fixed_to_unfixed_sol(result_3p.sol, fixing, best_sol);
+                sol_time = env.timer.elapsed<sec>();
+                CFT_IF_DEBUG(check_inst_solution(orig_inst, best_sol));
+            }
+            if (incumbent != nullptr && incumbent->cost() < best_sol.cost) {
+                best_sol = incumbent->solution();  // Found by another run
+                sol_time = env.timer.elapsed<sec>();
+            }
 
-        if (best_sol.cost <= max_cost || env.timer.elapsed<sec>() > env.time_limit)
-            break;
+            if (iter_counter == 0) {
+                nofix_dual = std::move(result_3p.dual);
+                max_cost   = env.beta * nofix_dual.lb + env.epsilon;
+            }
 
-        inst             = orig_inst;
-        auto cols_to_fix = select_cols_to_fix(env, inst, nofix_dual.mults, best_sol);
-        if (!cols_to_fix.empty()) {
-            make_identity_fixing_data(ncols, nrows, fixing);
-            fix_columns_and_compute_maps(cols_to_fix, inst, fixing, old2new);
+            if (best_sol.cost <= max_cost && incumbent != nullptr)
+                incumbent->request_stop();  // Gap closed, the other runs can stop too
+            if (best_sol.cost <= max_cost || stop_requested(env) ||
+                (incumbent != nullptr && incumbent->stop_requested()))
+                break;
+
+            // The fixed instance is rebuilt from orig_inst into the buffers of inst, without
+            // copying orig_inst first
+            {
+                ProfileScope prof_scope(env.profile.refinement_fixing);
+                auto const&  cols_to_fix = select_cols_to_fix(
+                    env, orig_inst, nofix_dual.mults, best_sol);
+                make_identity_fixing_data(ncols, nrows, fixing);
+                if (cols_to_fix.empty())
+                    inst = orig_inst;
+                else
+                    fix_columns_and_compute_maps(cols_to_fix, orig_inst, inst, fixing, old2new);
+                env.profile.refinement_fixing.work += cols_to_fix.size();
+            }
+            real_t nrows_real = as_real(rsize(orig_inst.rows));
+            real_t free_perc  = as_real(rsize(inst.rows)) * 100.0_F / nrows_real;
+            print<2>(env,
+                     "REFN> {:2}: Best solution {:.2f}, lb {:.2f}, gap {:.2f}%\n",
+                     iter_counter,
+                     best_sol.cost,
+                     nofix_dual.lb,
+                     100.0_F * (best_sol.cost - nofix_dual.lb) / best_sol.cost);
+            print<2>(env,
+                     "REFN> {:2}: Fixed cost {:.2f}, free rows {:.0f}%, time {:.2f}s\n\n",
+                     iter_counter,
+                     fixing.fixed_cost,
+                     free_perc,
+                     env.timer.elapsed<sec>());
+
+            if (inst.rows.empty() || stop_requested(env))
+                break;
         }
-        real_t nrows_real = as_real(rsize(orig_inst.rows));
-        real_t free_perc  = as_real(rsize(inst.rows)) * 100.0_F / nrows_real;
-        print<2>(env,
-                 "REFN> {:2}: Best solution {:.2f}, lb {:.2f}, gap {:.2f}%\n",
-                 iter_counter,
-                 best_sol.cost,
-                 nofix_dual.lb,
-                 100.0_F * (best_sol.cost - nofix_dual.lb) / best_sol.cost);
-        print<2>(env,
-                 "REFN> {:2}: Fixed cost {:.2f}, free rows {:.0f}%, time {:.2f}s\n\n",
-                 iter_counter,
-                 fixing.fixed_cost,
-                 free_perc,
-                 env.timer.elapsed<sec>());
-
-        if (inst.rows.empty() || env.timer.elapsed<sec>() > env.time_limit)
-            break;
+        return {std::move(best_sol), std::move(nofix_dual), sol_time, {}};
+    }
+
+    // Portfolio of independent Refinement runs, one per thread, each with its own seed. Runs share
+    // the incumbent, the returned dual is the one with the highest lower bound.
+    inline CftResult run_portfolio(Environment const& env,            // in
+                                   Instance const&    orig_inst,      // in
+                                   Solution const&    warmstart_sol,  // in
+                                   DualState const&   warmstart_dual  // in
+    ) {
+        size_t const nworkers = checked_cast<size_t>(env.portfolio);
+        auto         results  = std::vector<CftResult>(nworkers);
+        auto         profiles = std::vector<Profile>(nworkers);
+        SharedIncumbent incumbent(warmstart_sol, env.notifier);  // Neither copyable nor movable
+
+        parallel_run(nworkers, [&](size_t w) {
+            auto worker_env     = env;
+            worker_env.seed     = env.seed + w;
+            worker_env.rnd      = prng_t(worker_env.seed);
+            worker_env.nthreads = max(env.nthreads / nworkers, uint64_t{1});
+            if (w > 0)
+                worker_env.verbose = min(env.verbose, uint64_t{1});  // Avoid interleaved logs
+            results[w] = run_refinement(
+                worker_env, orig_inst, warmstart_sol, warmstart_dual, &incumbent);
+            profiles[w] = worker_env.profile;
+        });
+        for (Profile const& prof : profiles)
+            env.profile += prof;  // Summed over workers, times are CPU rather than wall times
+
+        auto res     = CftResult();
+        res.sol      = incumbent.solution();
+        res.sol_time = limits<double>::inf();
+        res.dual     = std::move(results[0].dual);
+        for (size_t w = 1; w < nworkers; ++w)
+            if (results[w].dual.lb > res.dual.lb)
+                res.dual = std::move(results[w].dual);
+        for (CftResult const& r : results)  // Runs adopting it from the incumbent come later
+            if (r.sol.cost == res.sol.cost)
+                res.sol_time = min(res.sol_time, r.sol_time);
+        if (res.sol_time == limits<double>::inf())
+            res.sol_time = 0.0;  // Warmstart
+        print<2>(env, "REFN> Portfolio of {} runs, best solution {:.2f}\n", nworkers, res.sol.cost);
+        return res;
     }
-    return {std::move(best_sol), std::move(nofix_dual)};
+}  // namespace
+}  // namespace local
+
+// Complete CFT algorithm. With env.portfolio > 1, several Refinement runs are executed concurrently
+// sharing the best solution found. Per-component timings are returned in the result and, if
+// env.profile_path is set, also written to that file. If env.on_incumbent is set, it is called
+// from a separate thread with each improving solution, and all the calls are done when run returns.
+// A warmstart_dual (e.g., the dual of a previous result on a similar instance) seeds the first
+// subgradient phase; it is ignored if its number of multipliers does not match orig_inst.
+inline CftResult run(Environment const& env,                 // in
+                     Instance const&    orig_inst,           // in
+                     Solution const&    warmstart_sol  = {},  // in
+                     DualState const&   warmstart_dual = {}   // in
+) {
+    auto run_env    = env;  // env is left untouched, it might be shared with other runs
+    run_env.profile = Profile();
+    IncumbentNotifier notifier(run_env);  // Neither copyable nor movable
+
+    auto res = run_env.portfolio > 1
+                   ? local::run_portfolio(run_env, orig_inst, warmstart_sol, warmstart_dual)
+                   : local::run_refinement(
+                         run_env, orig_inst, warmstart_sol, warmstart_dual, nullptr);
+    notifier.finish();
+    res.profile = run_env.profile;
+    if (!env.profile_path.empty())
+        write_profile(env.profile_path, res.profile);
+    return res;
 }
 
 }  // namespace cft
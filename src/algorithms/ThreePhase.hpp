@@ -6,6 +6,7 @@
 
 
 #include "core/Instance.hpp"
+#include "core/SharedIncumbent.hpp"
 #include "core/cft.hpp"
 #include "fixing/ColFixing.hpp"
 #include "greedy/Greedy.hpp"
@@ -16,7 +17,9 @@
 namespace cft {
 
 class ThreePhase {
-    static constexpr real_t init_step_size = 0.1_F;
+    static constexpr real_t init_step_size   = 0.1_F;
+    static constexpr size_t cold_exit_period = 300;  // Subgradient stagnation window
+    static constexpr size_t warm_exit_period = 150;  // Same, for a warm-started first subgradient
 
     // Caches
     Subgradient         subgrad;     // Subgradient functor
@@ -32,42 +35,77 @@ class ThreePhase {
 
 public:
     // 3-phase algorithm consisting in subgradient, greedy and column fixing.
+    // If an incumbent is given, its cost is used as cutoff and improving solutions are published to
+    // it as soon as they are found. inst_fixing maps inst to the instance of the incumbent. Without
+    // an incumbent, improving solutions are published to env.notifier (if set, see run()).
+    // If a warm dual state is given (e.g., from a previous run on a similar instance), the first
+    // subgradient starts from its multipliers, core columns and step size instead of from scratch.
     // NOTE: inst gets progressively fixed inplace, loosing its original state.
-    CftResult operator()(Environment const& env,  // in
-                         Instance&          inst  // in/cache
+    CftResult operator()(Environment const& env,                    // in
+                         Instance&          inst,                   // in/cache
+                         SharedIncumbent*   incumbent   = nullptr,  // inout
+                         FixingData const*  inst_fixing = nullptr,  // in
+                         DualState const*   warm_dual   = nullptr   // in
     ) {
+        assert((incumbent == nullptr || inst_fixing != nullptr) && "Incumbent needs its mapping");
         ridx_t const orig_nrows = rsize(inst.rows);  // Original number of rows for ColFixing
 
+        if (warm_dual != nullptr && rsize(warm_dual->mults) != orig_nrows)
+            warm_dual = nullptr;  // Not a dual state of inst
+
         auto tot_timer = Chrono<>();
-        _three_phase_setup(inst, greedy, sol, best_sol, core, lagr_mult, fixing);
+        greedy.set_enum_limits(env.enum_vars, env.enum_nodes);  // Also used by col_fixing
+        _three_phase_setup(inst, warm_dual, greedy, sol, best_sol, core, lagr_mult, fixing);
+        _publish_sol(env, best_sol, inst_fixing, incumbent);
 
         CFT_IF_DEBUG(auto inst_copy = inst);
         for (size_t iter_counter = 0; !inst.rows.empty(); ++iter_counter) {
             auto timer = Chrono<>();
             print<3>(env, "3PHS> Three-phase iteration {}:\n", iter_counter);
 
-            real_t step_size = init_step_size;
-            auto   cutoff    = best_sol.cost - fixing.fixed_cost;
-            auto   real_lb   = subgrad(env, inst, cutoff, pricer, core, step_size, lagr_mult);
-
-            if (iter_counter == 0)
-                nofix_dual = {lagr_mult, real_lb};
+            // A warm start never starts from a smaller step size: if the instance has been
+            // perturbed, the subgradient could not move the multipliers far enough. It already
+            // starts close to a stationary point, so stagnation is detected on a shorter window.
+            real_t step_size   = init_step_size;
+            size_t exit_period = cold_exit_period;
+            if (iter_counter == 0 && warm_dual != nullptr) {
+                step_size   = max(warm_dual->step_size, step_size);
+                exit_period = warm_exit_period;
+            }
+            auto cutoff  = _upper_bound(incumbent, inst_fixing) - fixing.fixed_cost;
+            auto real_lb = subgrad(
+                env, inst, cutoff, pricer, core, step_size, lagr_mult, exit_period);
+
+            if (iter_counter == 0) {
+                nofix_dual.mults     = lagr_mult;  // Reuses the cache capacity
+                nofix_dual.lb        = real_lb;
+                nofix_dual.core_cols = core.col_map;
+                nofix_dual.step_size = step_size;
+                if (env.notifier != nullptr && _is_unfixed(inst_fixing))
+                    env.notifier->raise_lower_bound(real_lb);
+            }
 
-            if (real_lb + fixing.fixed_cost >= best_sol.cost - env.epsilon ||
-                env.timer.elapsed<sec>() > env.time_limit)
+            if (real_lb + fixing.fixed_cost >= _upper_bound(incumbent, inst_fixing) - env.epsilon ||
+                stop_requested(env) ||
+                (incumbent != nullptr && incumbent->stop_requested()))
                 break;
 
+            // Sol get filled only if one with cost < cutoff is found (other runs sharing the
+            // incumbent might have tightened it during the subgradient)
             sol.idxs.clear();
-            sol.cost = cutoff;  // Sol get filled only if one with cost < cutoff is found
+            sol.cost = _upper_bound(incumbent, inst_fixing) - fixing.fixed_cost;
             subgrad.heuristic(env, core.inst, step_size, greedy, sol, lagr_mult);
 
-            if (sol.cost + fixing.fixed_cost < best_sol.cost) {
+            if (sol.cost + fixing.fixed_cost < best_sol.cost && !sol.idxs.empty()) {
                 _from_core_to_unfixed_sol(sol, core, fixing, best_sol);
                 CFT_IF_DEBUG(check_inst_solution(inst_copy, best_sol));
+                _publish_sol(env, best_sol, inst_fixing, incumbent);
             }
+            if (stop_requested(env) || (incumbent != nullptr && incumbent->stop_requested()))
+                break;  // Skip fixing and pricing, which are useful only to the next iteration
 
             col_fixing(env, orig_nrows, inst, fixing, lagr_mult, greedy);  // Fix column in inst
-            real_lb = pricer(inst, lagr_mult, core);        // Update core-inst for next iter
+            real_lb = pricer(env, inst, lagr_mult, core);   // Update core-inst for next iter
             _perturb_lagr_multipliers(lagr_mult, env.rnd);  // Multipliers +-10% perturbation
 
             print<3>(env, "3PHS> Remaining rows:     {}\n", rsize(inst.rows));
@@ -79,7 +117,7 @@ public:
             print<3>(env, "3PHS> Iteration time:     {:.2f}s\n\n", timer.elapsed<sec>());
 
             // For some reason, it seems that we get the tightest bound after the column fixing
-            if (real_lb + fixing.fixed_cost >= best_sol.cost - env.epsilon)
+            if (real_lb + fixing.fixed_cost >= _upper_bound(incumbent, inst_fixing) - env.epsilon)
                 break;
         }
 
@@ -87,11 +125,49 @@ public:
                  "3PHS> Best solution: {:.2f}, time: {:.2f}s\n\n",
                  best_sol.cost,
                  tot_timer.elapsed<sec>());
-        return {best_sol, nofix_dual};
+        greedy.flush_profile(env.profile);
+        return {best_sol, nofix_dual, 0.0, {}};
     }
 
 private:
+    // Best known cost for inst, possibly improved by the shared incumbent.
+    real_t _upper_bound(SharedIncumbent const* incumbent,   // in
+                        FixingData const*      inst_fixing  // in
+    ) const {
+        if (incumbent == nullptr)
+            return best_sol.cost;
+        return min(best_sol.cost, incumbent->cost() - inst_fixing->fixed_cost);
+    }
+
+    // True if inst is the original instance (no column has been fixed by the caller).
+    static bool _is_unfixed(FixingData const* inst_fixing) {
+        return inst_fixing == nullptr || inst_fixing->fixed_cols.empty();
+    }
+
+    // Maps a solution of inst back to the instance of the incumbent and offers it. Without a
+    // shared incumbent, it is published to the notifier of the run, if any.
+    static void _publish_sol(Environment const& env,          // in
+                             Solution const&    inst_sol,     // in
+                             FixingData const*  inst_fixing,  // in
+                             SharedIncumbent*   incumbent     // inout
+    ) {
+        if (incumbent == nullptr && (env.notifier == nullptr || inst_fixing == nullptr))
+            return;
+        auto orig_sol = Solution();
+        orig_sol.cost = inst_sol.cost + inst_fixing->fixed_cost;
+        if (orig_sol.cost >= (incumbent != nullptr ? incumbent->cost() : env.notifier->cost()))
+            return;  // Avoid the copy
+        orig_sol.idxs = inst_fixing->fixed_cols;
+        for (cidx_t j : inst_sol.idxs)
+            orig_sol.idxs.push_back(inst_fixing->curr2orig.col_map[j]);
+        if (incumbent != nullptr)
+            incumbent->try_update(orig_sol);
+        else
+            env.notifier->publish(orig_sol);
+    }
+
     static void _three_phase_setup(Instance const&      inst,       // in
+                                   DualState const*     warm_dual,  // in
                                    Greedy&              greedy,     // cache
                                    Solution&            sol,        // cache
                                    Solution&            best_sol,   // out
@@ -99,8 +175,13 @@ private:
                                    std::vector<real_t>& lagr_mult,  // out
                                    FixingData&          fixing      // out
     ) {
-        _build_tentative_core_instance(inst, core);         // init core instance
-        _compute_greedy_multipliers(core.inst, lagr_mult);  // compute initial multipliers
+        auto const no_cols = std::vector<cidx_t>();
+        _build_tentative_core_instance(
+            inst, warm_dual != nullptr ? warm_dual->core_cols : no_cols, core);  // init core
+        if (warm_dual != nullptr)
+            lagr_mult = warm_dual->mults;
+        else
+            _compute_greedy_multipliers(core.inst, lagr_mult);  // compute initial multipliers
         make_identity_fixing_data(csize(inst.cols), rsize(inst.rows), fixing);  // init fixing
 
         // init sol
@@ -150,8 +231,11 @@ private:
         }
     }
 
-    static void _build_tentative_core_instance(Instance const& inst,      // in
-                                               InstAndMap&     core_inst  // out
+    // The tentative core takes the first columns of each row, plus extra_cols (e.g., the core of a
+    // previous run) whose indexes are valid for inst.
+    static void _build_tentative_core_instance(Instance const&            inst,        // in
+                                               std::vector<cidx_t> const& extra_cols,  // in
+                                               InstAndMap&                core_inst    // out
     ) {
         static constexpr cidx_t min_row_coverage = 5_C;
         ridx_t const            nrows            = rsize(inst.rows);
@@ -160,12 +244,18 @@ private:
         core_inst.col_map.clear();
 
         // Select the first n columns of each row (there might be duplicates)
-        core_inst.col_map.reserve(checked_cast<size_t>(as_cidx(nrows) * min_row_coverage));
-        for (auto const& row : inst.rows)
+        core_inst.col_map.reserve(checked_cast<size_t>(as_cidx(nrows) * min_row_coverage) +
+                                  extra_cols.size());
+        for (ridx_t i = 0_R; i < nrows; ++i) {
+            auto row = inst.rows[i];
             for (size_t n = 0; n < min(row.size(), min_row_coverage); ++n) {
                 cidx_t j = row[n];  // column covering row i
                 core_inst.col_map.push_back(j);
             }
+        }
+        for (cidx_t j : extra_cols)
+            if (0_C <= j && j < csize(inst.cols))
+                core_inst.col_map.push_back(j);
 
         // There might be duplicates, so let's sort the column list to detect them
         cft::sort(core_inst.col_map);
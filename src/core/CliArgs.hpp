@@ -27,7 +27,7 @@ namespace cft {
 #define CFT_PARSER_LONG_FLAG "--parser"
 #define CFT_PARSER_HELP                                                            \
     "Available parsers: " CFT_RAIL_PARSER ", " CFT_SCP_PARSER ", " CFT_CVRP_PARSER \
-    ", " CFT_MPS_PARSER "."
+    ", " CFT_MPS_PARSER ", " CFT_BINARY_PARSER "."
 
 #define CFT_OUTSOL_FLAG      "-o"
 #define CFT_OUTSOL_LONG_FLAG "--out-sol"
@@ -73,6 +73,40 @@ namespace cft {
 #define CFT_UNITCOST_LONG_FLAG "--unit-costs"
 #define CFT_UNITCOST_HELP      "Solve the given instance setting columns costs to one."
 
+#define CFT_MMAP_FLAG      "-m"
+#define CFT_MMAP_LONG_FLAG "--mmap"
+#define CFT_MMAP_HELP      "Memory-map the instance file while parsing text formats."
+
+#define CFT_NTHREADS_FLAG      "-n"
+#define CFT_NTHREADS_LONG_FLAG "--nthreads"
+#define CFT_NTHREADS_HELP      "Number of worker threads (RAIL/CVRP parsing, pricing, heuristic)."
+
+#define CFT_PORTFOLIO_FLAG      "-f"
+#define CFT_PORTFOLIO_LONG_FLAG "--portfolio"
+#define CFT_PORTFOLIO_HELP                                                         \
+    "Number of concurrent runs with different seeds sharing the best solution (threads are split)."
+
+#define CFT_ENUMVARS_FLAG      "-x"
+#define CFT_ENUMVARS_LONG_FLAG "--enum-vars"
+#define CFT_ENUMVARS_HELP      "Redundant columns of a greedy solution left to enumerate (<= 64)."
+
+#define CFT_ENUMNODES_FLAG      "-y"
+#define CFT_ENUMNODES_LONG_FLAG "--enum-nodes"
+#define CFT_ENUMNODES_HELP      "Node budget of the redundant columns enumeration."
+
+#define CFT_CONVERT_FLAG      "-c"
+#define CFT_CONVERT_LONG_FLAG "--convert"
+#define CFT_CONVERT_HELP      "Save the instance in " CFT_BINARY_PARSER " format to the given file."
+
+#define CFT_PROFILE_FLAG      "-P"
+#define CFT_PROFILE_LONG_FLAG "--profile"
+#define CFT_PROFILE_HELP      "File where per-component timings are written (CSV if *.csv)."
+
+#define CFT_CHECKPOINT_FLAG      "-k"
+#define CFT_CHECKPOINT_LONG_FLAG "--checkpoint"
+#define CFT_CHECKPOINT_HELP                                                        \
+    "Solver state file: used to warm start if present, then updated. Helps when few costs change."
+
 namespace local { namespace {
     inline std::string make_sol_name(std::string const& inst_path) {
         auto out_name = cft::StringView(inst_path);
@@ -114,6 +148,17 @@ inline void print_arg_values(Environment const& env) {
              " {:20} = {}\n",
              CFT_UNITCOST_FLAG "," CFT_UNITCOST_LONG_FLAG,
              env.use_unit_costs);
+    print<3>(env, " {:20} = {}\n", CFT_MMAP_FLAG "," CFT_MMAP_LONG_FLAG, env.use_mmap);
+    print<3>(env, " {:20} = {}\n", CFT_NTHREADS_FLAG "," CFT_NTHREADS_LONG_FLAG, env.nthreads);
+    print<3>(env, " {:20} = {}\n", CFT_PORTFOLIO_FLAG "," CFT_PORTFOLIO_LONG_FLAG, env.portfolio);
+    print<3>(env, " {:20} = {}\n", CFT_ENUMVARS_FLAG "," CFT_ENUMVARS_LONG_FLAG, env.enum_vars);
+    print<3>(env, " {:20} = {}\n", CFT_ENUMNODES_FLAG "," CFT_ENUMNODES_LONG_FLAG, env.enum_nodes);
+    print<3>(env, " {:20} = {}\n", CFT_CONVERT_FLAG "," CFT_CONVERT_LONG_FLAG, env.convert_path);
+    print<3>(env, " {:20} = {}\n", CFT_PROFILE_FLAG "," CFT_PROFILE_LONG_FLAG, env.profile_path);
+    print<3>(env,
+             " {:20} = {}\n",
+             CFT_CHECKPOINT_FLAG "," CFT_CHECKPOINT_LONG_FLAG,
+             env.checkpoint_path);
     print<3>(env, "\n");
     std::fflush(stdout);
 }
@@ -134,6 +179,15 @@ inline void print_cli_help_msg() {
     fmt::print("  {:20} " CFT_ABSSGEXIT_HELP "\n", CFT_ABSSGEXIT_FLAG "," CFT_ABSSGEXIT_LONG_FLAG);
     fmt::print("  {:20} " CFT_RELSGEXIT_HELP "\n", CFT_RELSGEXIT_FLAG "," CFT_RELSGEXIT_LONG_FLAG);
     fmt::print("  {:20} " CFT_UNITCOST_HELP "\n", CFT_UNITCOST_FLAG "," CFT_UNITCOST_LONG_FLAG);
+    fmt::print("  {:20} " CFT_MMAP_HELP "\n", CFT_MMAP_FLAG "," CFT_MMAP_LONG_FLAG);
+    fmt::print("  {:20} " CFT_NTHREADS_HELP "\n", CFT_NTHREADS_FLAG "," CFT_NTHREADS_LONG_FLAG);
+    fmt::print("  {:20} " CFT_PORTFOLIO_HELP "\n", CFT_PORTFOLIO_FLAG "," CFT_PORTFOLIO_LONG_FLAG);
+    fmt::print("  {:20} " CFT_ENUMVARS_HELP "\n", CFT_ENUMVARS_FLAG "," CFT_ENUMVARS_LONG_FLAG);
+    fmt::print("  {:20} " CFT_ENUMNODES_HELP "\n", CFT_ENUMNODES_FLAG "," CFT_ENUMNODES_LONG_FLAG);
+    fmt::print("  {:20} " CFT_CONVERT_HELP "\n", CFT_CONVERT_FLAG "," CFT_CONVERT_LONG_FLAG);
+    fmt::print("  {:20} " CFT_PROFILE_HELP "\n", CFT_PROFILE_FLAG "," CFT_PROFILE_LONG_FLAG);
+    fmt::print("  {:20} " CFT_CHECKPOINT_HELP "\n",
+               CFT_CHECKPOINT_FLAG "," CFT_CHECKPOINT_LONG_FLAG);
     fmt::print("\n");
     fmt::print("Default values:\n");
     print_arg_values(Environment{});
@@ -154,6 +208,8 @@ inline Environment parse_cli_args(int argc, char const** argv) {
             print_cli_help_msg();
         else if (CFT_FLAG_MATCH(arg, UNITCOST))
             env.use_unit_costs = true;
+        else if (CFT_FLAG_MATCH(arg, MMAP))
+            env.use_mmap = true;
         else if (a + 1 >= asize)
             fmt::print("Missing value of argument {}.\n", arg.data());
         else if (CFT_FLAG_MATCH(arg, INST))
@@ -164,12 +220,26 @@ inline Environment parse_cli_args(int argc, char const** argv) {
             env.sol_path = args[++a];
         else if (CFT_FLAG_MATCH(arg, INITSOL))
             env.initsol_path = args[++a];
+        else if (CFT_FLAG_MATCH(arg, CONVERT))
+            env.convert_path = args[++a];
+        else if (CFT_FLAG_MATCH(arg, PROFILE))
+            env.profile_path = args[++a];
+        else if (CFT_FLAG_MATCH(arg, CHECKPOINT))
+            env.checkpoint_path = args[++a];
         else if (CFT_FLAG_MATCH(arg, SEED))
             env.rnd = prng_t(env.seed = string_to<uint64_t>::parse(args[++a]));
         else if (CFT_FLAG_MATCH(arg, TLIM))
             env.time_limit = string_to<double>::parse(args[++a]);
         else if (CFT_FLAG_MATCH(arg, VERBOSE))
             env.verbose = string_to<uint64_t>::parse(args[++a]);
+        else if (CFT_FLAG_MATCH(arg, NTHREADS))
+            env.nthreads = string_to<uint64_t>::parse(args[++a]);
+        else if (CFT_FLAG_MATCH(arg, PORTFOLIO))
+            env.portfolio = string_to<uint64_t>::parse(args[++a]);
+        else if (CFT_FLAG_MATCH(arg, ENUMVARS))
+            env.enum_vars = string_to<uint64_t>::parse(args[++a]);
+        else if (CFT_FLAG_MATCH(arg, ENUMNODES))
+            env.enum_nodes = string_to<uint64_t>::parse(args[++a]);
         else if (CFT_FLAG_MATCH(arg, EPSILON))
             env.epsilon = string_to<real_t>::parse(args[++a]);
         else if (CFT_FLAG_MATCH(arg, GITERS))
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef CFT_SRC_CORE_INCUMBENTNOTIFIER_HPP
+#define CFT_SRC_CORE_INCUMBENTNOTIFIER_HPP
+
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <thread>
+
+#include "core/cft.hpp"
+#include "utils/SpscQueue.hpp"
+#include "utils/limits.hpp"
+#include "utils/utility.hpp"
+
+namespace cft {
+
+// Delivers the improving solutions of a run to env.on_incumbent while the run goes on. Solver
+// threads only push into a bounded lock-free queue; the callback is invoked by a dedicated thread,
+// so a slow callback never stalls the solver. If the queue is full, the newest solution is kept
+// aside and pushed at the next improvement, hence some intermediate solutions might be skipped,
+// but the last one is always delivered before finish() returns.
+// While alive, the notifier is reachable from env.notifier, with env being the run's own copy of the
+// Environment; if env.on_incumbent is not set, it does nothing at all.
+class IncumbentNotifier {
+    static constexpr size_t queue_capacity = 64;
+
+    // Consumer polling period. Not a static constexpr member: milliseconds takes its count by
+    // reference, which in C++11 would require an out-of-class definition.
+    static std::chrono::milliseconds poll_period() {
+        return std::chrono::milliseconds(1);
+    }
+
+    struct Event {
+        Solution sol;
+        real_t   lb   = 0.0_F;
+        double   time = 0.0;
+    };
+
+    Environment&        env;
+    SpscQueue<Event>    queue{queue_capacity};
+    Event               pending;                              // Producer side only
+    bool                has_pending = false;                  // Producer side only
+    real_t              best_cost   = limits<real_t>::max();  // Producer side only
+    std::atomic<double> lower_bound{0.0};
+    std::atomic<bool>   done{false};
+    std::exception_ptr  error;  // Thrown by the callback, rethrown by finish()
+    std::thread         consumer;
+
+public:
+    explicit IncumbentNotifier(Environment& environment)
+        : env(environment) {
+        if (!env.on_incumbent)
+            return;
+        consumer     = std::thread([this] { _consume(); });
+        env.notifier = this;
+    }
+
+    IncumbentNotifier(IncumbentNotifier const&)            = delete;
+    IncumbentNotifier& operator=(IncumbentNotifier const&) = delete;
+
+    ~IncumbentNotifier() {
+        if (consumer.joinable()) {
+            _stop();
+            env.notifier = nullptr;
+        }
+    }
+
+    // Cost of the last published solution.
+    real_t cost() const {
+        return best_cost;
+    }
+
+    // Raises the lower bound reported with the next solutions (0 until the first one is known).
+    // Can be called concurrently by any thread.
+    void raise_lower_bound(real_t lb) {
+        auto new_lb = static_cast<double>(native_cast(lb));
+        auto old_lb = lower_bound.load(std::memory_order_relaxed);
+        while (new_lb > old_lb &&
+               !lower_bound.compare_exchange_weak(old_lb, new_lb, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Producer side: queues sol if it improves the last published one. Calls must be serialized.
+    void publish(Solution const& sol) {
+        if (sol.cost >= best_cost)
+            return;
+        best_cost    = sol.cost;
+        pending.sol  = sol;
+        pending.lb   = as_real(lower_bound.load(std::memory_order_relaxed));
+        pending.time = env.timer.elapsed<sec>();
+        has_pending  = !queue.try_push(pending);
+    }
+
+    // Delivers the remaining solutions and stops the consumer thread. If the callback threw, the
+    // exception is rethrown here.
+    void finish() {
+        if (!consumer.joinable())
+            return;
+        _stop();
+        env.notifier = nullptr;
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    void _stop() {
+        while (has_pending && !queue.try_push(pending))  // Waits for the consumer to make room
+            std::this_thread::sleep_for(poll_period());
+        has_pending = false;
+        done.store(true, std::memory_order_release);
+        consumer.join();
+    }
+
+    void _consume() {
+        auto event = Event();
+        for (;;) {
+            bool last_round = done.load(std::memory_order_acquire);
+            while (queue.try_pop(event))
+                if (!error) {
+                    try {
+                        env.on_incumbent(event.sol, event.lb, event.time);
+                    } catch (...) {
+                        error = std::current_exception();  // Following solutions are dropped
+                    }
+                }
+            if (last_round)
+                return;
+            std::this_thread::sleep_for(poll_period());
+        }
+    }
+};
+
+}  // namespace cft
+
+
+#endif /* CFT_SRC_CORE_INCUMBENTNOTIFIER_HPP */
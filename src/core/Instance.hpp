@@ -19,9 +19,9 @@ namespace cft {
 
 // A data structure representing an instance using sparse binary matrix representation.
 struct Instance {
-    SparseBinMat<ridx_t>             cols;
-    std::vector<std::vector<cidx_t>> rows;
-    std::vector<real_t>              costs;
+    SparseBinMat<ridx_t> cols;
+    SparseBinMat<cidx_t> rows;
+    std::vector<real_t>  costs;
 };
 
 // For core instance we only need column mappings, since the rows remain the same.
@@ -37,8 +37,8 @@ struct IdxsMaps {
 };
 
 #ifndef NDEBUG
-inline void col_and_rows_check(SparseBinMat<ridx_t> const&             cols,
-                               std::vector<std::vector<cidx_t>> const& rows) {
+inline void col_and_rows_check(SparseBinMat<ridx_t> const& cols,
+                               SparseBinMat<cidx_t> const& rows) {
     for (cidx_t j = 0_C; j < csize(cols); ++j) {
         assert("Col is empty" && !cols[j].empty());
         assert("Col does not exist" && j < csize(cols));
@@ -56,20 +56,24 @@ inline void col_and_rows_check(SparseBinMat<ridx_t> const&             cols,
 
 #endif
 
-// Completes instance initialization by creating rows
-inline void fill_rows_from_cols(SparseBinMat<ridx_t> const&       cols,   // in
-                                ridx_t                            nrows,  // in
-                                std::vector<std::vector<cidx_t>>& rows    // out
+// Completes instance initialization by creating rows. The transpose is done in two passes: first
+// the size of each row is counted, then column indexes are scattered into their final position.
+// Columns are visited backwards so that each row ends up sorted by increasing column index.
+inline void fill_rows_from_cols(SparseBinMat<ridx_t> const& cols,   // in
+                                ridx_t                      nrows,  // in
+                                SparseBinMat<cidx_t>&       rows    // out
 ) {
-    rows.resize(nrows);
-    for (auto& row : rows) {
-        row.clear();
-        row.reserve(csize(cols.idxs) / as_cidx(nrows));
-    }
-
-    for (cidx_t j = 0_C; j < csize(cols); ++j)
+    rows.begs.assign(nrows + 1_R, 0);
+    for (ridx_t i : cols.idxs)
+        ++rows.begs[i];
+    for (ridx_t i = 1_R; i <= nrows; ++i)  // begs[i] = end of row i
+        rows.begs[i] += rows.begs[i - 1_R];
+
+    rows.idxs.resize(cols.idxs.size());
+    for (cidx_t j = csize(cols); j-- > 0_C;)
         for (ridx_t i : cols[j])
-            rows[i].push_back(j);
+            rows.idxs[--rows.begs[i]] = j;  // begs[i] = begin of row i when done
+    assert(rows.begs[nrows] == rows.idxs.size());
 }
 
 // Copy a column from one instance to another pushing it back as last column.
@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef CFT_SRC_CORE_INSTANCEDELTA_HPP
+#define CFT_SRC_CORE_INSTANCEDELTA_HPP
+
+
+#include <fmt/core.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "core/Instance.hpp"
+#include "core/cft.hpp"
+#include "utils/SparseBinMat.hpp"
+#include "utils/utility.hpp"
+
+namespace cft {
+
+// Column changes between two versions of an instance with the same rows. Indexes of removed and
+// re-costed columns refer to the old instance; added columns are appended after the kept ones.
+struct InstanceDelta {
+    std::vector<cidx_t>      removed_cols;  // Columns to remove
+    std::vector<CidxAndCost> new_costs;     // Columns whose cost changes, with the new cost
+    SparseBinMat<ridx_t>     added_cols;    // Columns to append...
+    std::vector<real_t>      added_costs;   // ... and their costs
+};
+
+namespace local { namespace {
+    inline void check_instance_delta(Instance const& inst, InstanceDelta const& delta) {
+        cidx_t const ncols = csize(inst.cols);
+        ridx_t const nrows = rsize(inst.rows);
+
+        auto out_of_range = [=](cidx_t j) { return j < 0_C || j >= ncols; };
+        if (any(delta.removed_cols, out_of_range))
+            throw std::invalid_argument("Instance delta: removed column out of range.");
+        if (any(delta.new_costs, [&](CidxAndCost c) { return out_of_range(c.idx); }))
+            throw std::invalid_argument("Instance delta: re-costed column out of range.");
+        if (csize(delta.added_cols) != csize(delta.added_costs))
+            throw std::invalid_argument(
+                fmt::format("Instance delta: {} added columns but {} costs.",
+                            delta.added_cols.size(),
+                            delta.added_costs.size()));
+        if (any(delta.added_cols.idxs, [=](ridx_t i) { return i < 0_R || i >= nrows; }))
+            throw std::invalid_argument("Instance delta: added column with row out of range.");
+    }
+}  // namespace
+}  // namespace local
+
+// Applies delta to inst in place, reusing its buffers: kept columns are compacted, added columns
+// appended and rows rebuilt. old2new maps old column indexes to new ones (removed_cidx for the
+// removed columns). The delta is validated before touching inst; if afterwards a row is left
+// uncovered, std::invalid_argument is thrown (inst is updated anyway).
+inline void apply_instance_delta(InstanceDelta const& delta,   // in
+                                 Instance&            inst,    // inout
+                                 std::vector<cidx_t>& old2new  // out
+) {
+    local::check_instance_delta(inst, delta);
+    cidx_t const ncols = csize(inst.cols);
+    ridx_t const nrows = rsize(inst.rows);
+
+    for (CidxAndCost c : delta.new_costs)
+        inst.costs[c.idx] = c.cost;
+
+    old2new.assign(checked_cast<size_t>(ncols), 0_C);
+    for (cidx_t j : delta.removed_cols)
+        old2new[j] = removed_cidx;
+
+    // Compact the kept columns: writes never overtake the column being read
+    auto&  cols    = inst.cols;
+    size_t nnz     = 0;
+    size_t old_beg = 0;
+    cidx_t new_j   = 0_C;
+    for (cidx_t old_j = 0_C; old_j < ncols; ++old_j) {
+        size_t const old_end = cols.begs[old_j + 1_C];
+        if (old2new[old_j] != removed_cidx) {
+            old2new[old_j] = new_j;
+            for (size_t k = old_beg; k < old_end; ++k)
+                cols.idxs[nnz++] = cols.idxs[k];
+            inst.costs[new_j] = inst.costs[old_j];
+            cols.begs[++new_j] = nnz;
+        }
+        old_beg = old_end;
+    }
+    cols.idxs.resize(nnz);
+    cols.begs.resize(checked_cast<size_t>(new_j) + 1U);
+    inst.costs.resize(checked_cast<size_t>(new_j));
+
+    for (cidx_t j = 0_C; j < csize(delta.added_costs); ++j) {
+        cols.push_back(delta.added_cols[j]);
+        inst.costs.push_back(delta.added_costs[j]);
+    }
+
+    fill_rows_from_cols(cols, nrows, inst.rows);
+    for (ridx_t i = 0_R; i < nrows; ++i)
+        if (inst.rows[i].empty())
+            throw std::invalid_argument(fmt::format("Instance delta: row {} left uncovered.", i));
+}
+
+namespace local { namespace {
+    // Maps old column indexes to new ones in place, dropping removed (or invalid) ones.
+    inline void remap_cols(std::vector<cidx_t> const& old2new, std::vector<cidx_t>& idxs) {
+        remove_if(idxs, [&](cidx_t old_j) {
+            return old_j < 0_C || old_j >= csize(old2new) || old2new[old_j] == removed_cidx;
+        });
+        for (cidx_t& j : idxs)
+            j = old2new[j];
+    }
+}  // namespace
+}  // namespace local
+
+// Maps a solution of the old instance to the new one, dropping removed columns and recomputing the
+// cost with the new costs. The result might not be a cover anymore.
+inline void remap_solution(Instance const&            inst,     // in
+                           std::vector<cidx_t> const& old2new,  // in
+                           Solution&                  sol       // inout
+) {
+    local::remap_cols(old2new, sol.idxs);
+    sol.cost = 0.0_F;
+    for (cidx_t j : sol.idxs)
+        sol.cost += inst.costs[j];
+}
+
+// Maps a dual state of the old instance to the new one. Rows are unchanged, so multipliers are kept
+// as they are; core columns are remapped, dropping removed ones.
+inline void remap_dual_state(std::vector<cidx_t> const& old2new,  // in
+                             DualState&                 dual      // inout
+) {
+    local::remap_cols(old2new, dual.core_cols);
+}
+
+}  // namespace cft
+
+
+#endif /* CFT_SRC_CORE_INSTANCEDELTA_HPP */
@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef CFT_SRC_CORE_PROFILE_HPP
+#define CFT_SRC_CORE_PROFILE_HPP
+
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "utils/Chrono.hpp"
+
+namespace cft {
+
+// Accumulated wall time, number of calls and amount of work of a component.
+struct ProfileEntry {
+    double   seconds = 0.0;
+    uint64_t calls   = 0;
+    uint64_t work    = 0;  // Component specific counter, see Profile
+
+    ProfileEntry& operator+=(ProfileEntry const& other) {
+        seconds += other.seconds;
+        calls += other.calls;
+        work += other.work;
+        return *this;
+    }
+};
+
+// Per-component totals of a run. Times are inclusive: e.g., subgradient includes the pricing done
+// within it, and greedy includes redundancy.
+struct Profile {
+    ProfileEntry subgradient;        // work: iterations
+    ProfileEntry heuristic;          // work: iterations
+    ProfileEntry greedy;             // work: picked columns
+    ProfileEntry redundancy;         // work: enumeration nodes
+    ProfileEntry col_fixing;         // work: fixed columns
+    ProfileEntry pricing;            // work: scanned nonzeros
+    ProfileEntry refinement_fixing;  // work: fixed columns
+
+    Profile& operator+=(Profile const& other) {
+        subgradient += other.subgradient;
+        heuristic += other.heuristic;
+        greedy += other.greedy;
+        redundancy += other.redundancy;
+        col_fixing += other.col_fixing;
+        pricing += other.pricing;
+        refinement_fixing += other.refinement_fixing;
+        return *this;
+    }
+};
+
+// Adds its lifetime to the time of entry, counting one call.
+class ProfileScope {
+    ProfileEntry& entry;
+    Chrono<nsec>  timer;
+
+public:
+    explicit ProfileScope(ProfileEntry& prof_entry)
+        : entry(prof_entry) {
+    }
+
+    ProfileScope(ProfileScope const&)            = delete;
+    ProfileScope& operator=(ProfileScope const&) = delete;
+
+    ~ProfileScope() {
+        entry.seconds += timer.elapsed<sec>();
+        ++entry.calls;
+    }
+};
+
+namespace local { namespace {
+    // Calls func(name, work_unit, entry) for every component, in report order.
+    template <typename Func>
+    void for_each_profile_entry(Profile const& prof, Func func) {
+        func("subgradient", "iterations", prof.subgradient);
+        func("heuristic", "iterations", prof.heuristic);
+        func("greedy", "picked_columns", prof.greedy);
+        func("redundancy", "enumeration_nodes", prof.redundancy);
+        func("col_fixing", "fixed_columns", prof.col_fixing);
+        func("pricing", "scanned_nonzeros", prof.pricing);
+        func("refinement_fixing", "fixed_columns", prof.refinement_fixing);
+    }
+}  // namespace
+}  // namespace local
+
+inline std::string profile_to_json(Profile const& prof) {
+    auto out = std::string("{\n");
+    local::for_each_profile_entry(
+        prof, [&](char const* name, char const* unit, ProfileEntry const& entry) {
+            if (out.size() > 2)
+                out += ",\n";
+            out += fmt::format(
+                "  \"{}\": {{\"seconds\": {:.6f}, \"calls\": {}, \"work\": {}, \"work_unit\": "
+                "\"{}\"}}",
+                name,
+                entry.seconds,
+                entry.calls,
+                entry.work,
+                unit);
+        });
+    return out + "\n}\n";
+}
+
+inline std::string profile_to_csv(Profile const& prof) {
+    auto out = std::string("component,seconds,calls,work,work_unit\n");
+    local::for_each_profile_entry(
+        prof, [&](char const* name, char const* unit, ProfileEntry const& entry) {
+            out += fmt::format(
+                "{},{:.6f},{},{},{}\n", name, entry.seconds, entry.calls, entry.work, unit);
+        });
+    return out;
+}
+
+// Writes the report as CSV if path ends with ".csv", as JSON otherwise.
+inline void write_profile(std::string const& path, Profile const& prof) {
+    bool const csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    auto       out = std::ofstream(path);
+    if (!out.is_open())
+        throw std::runtime_error("Failed to open file for writing: " + path);
+    out << (csv ? profile_to_csv(prof) : profile_to_json(prof));
+}
+
+}  // namespace cft
+
+
+#endif /* CFT_SRC_CORE_PROFILE_HPP */
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef CFT_SRC_CORE_SHAREDINCUMBENT_HPP
+#define CFT_SRC_CORE_SHAREDINCUMBENT_HPP
+
+
+#include <atomic>
+#include <mutex>
+
+#include "core/IncumbentNotifier.hpp"
+#include "core/cft.hpp"
+#include "utils/limits.hpp"
+#include "utils/utility.hpp"
+
+namespace cft {
+
+// Best solution shared among concurrent solver runs. The cost is published through an atomic, so
+// checking it (e.g., to tighten a cutoff) is lock-free; the solution itself is only copied under
+// the lock, which is taken only when a worker finds an improving solution.
+// The cost is stored as double, since wider real_t types would not be lock-free.
+// If a notifier is given, improvements are published to it under the lock, so that it sees a
+// single producer at a time.
+class SharedIncumbent {
+    std::atomic<double> best_cost{limits<double>::inf()};
+    std::atomic<bool>   stop_flag{false};
+    mutable std::mutex  mtx;
+    Solution            best_sol;
+    IncumbentNotifier*  notifier = nullptr;
+
+public:
+    SharedIncumbent() = default;
+
+    explicit SharedIncumbent(Solution const& init_sol, IncumbentNotifier* sol_notifier = nullptr)
+        : notifier(sol_notifier) {
+        if (!init_sol.idxs.empty())
+            try_update(init_sol);
+    }
+
+    // Cost of the current best solution, limits<real_t>::max() if there is none yet.
+    real_t cost() const {
+        double c = best_cost.load(std::memory_order_acquire);
+        return c < limits<double>::inf() ? as_real(c) : limits<real_t>::max();
+    }
+
+    // Stores a copy of sol if it improves the current best one. Returns true on success.
+    bool try_update(Solution const& sol) {
+        auto sol_cost = static_cast<double>(native_cast(sol.cost));
+        if (sol_cost >= best_cost.load(std::memory_order_acquire))
+            return false;
+
+        std::lock_guard<std::mutex> lock(mtx);
+        if (sol_cost >= best_cost.load(std::memory_order_relaxed))
+            return false;  // Someone else got here first with a better one
+        best_sol = sol;
+        best_cost.store(sol_cost, std::memory_order_release);
+        if (notifier != nullptr)
+            notifier->publish(best_sol);
+        return true;
+    }
+
+    Solution solution() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return best_sol;
+    }
+
+    // Asks every run sharing this incumbent to terminate (e.g., optimality has been proven).
+    void request_stop() {
+        stop_flag.store(true, std::memory_order_relaxed);
+    }
+
+    bool stop_requested() const {
+        return stop_flag.load(std::memory_order_relaxed);
+    }
+};
+
+}  // namespace cft
+
+
+#endif /* CFT_SRC_CORE_SHAREDINCUMBENT_HPP */
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef CFT_SRC_CORE_STOPTOKEN_HPP
+#define CFT_SRC_CORE_STOPTOKEN_HPP
+
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "utils/limits.hpp"
+
+namespace cft {
+
+// Cooperative cancellation of a run: a stop flag plus a deadline, both atomics, so they can be set
+// by any thread (e.g., a controller or a signal handler) while the solver threads poll the token.
+// Polling costs a relaxed load and, only if a deadline is set, a steady clock read.
+class StopToken {
+    using clock = std::chrono::steady_clock;
+
+    static constexpr int64_t no_deadline = limits<int64_t>::max();
+
+    // Longer timeouts (and inf or NaN) never expire: clock ticks would overflow a few centuries on.
+    static constexpr double max_timeout_sec = 100.0 * 365.0 * 24.0 * 3600.0;
+
+    std::atomic<bool>    stop_flag{false};
+    std::atomic<int64_t> deadline{no_deadline};  // clock ticks since the clock epoch
+
+public:
+    StopToken() = default;
+
+    StopToken(StopToken const&)            = delete;
+    StopToken& operator=(StopToken const&) = delete;
+
+    void request_stop() {
+        stop_flag.store(true, std::memory_order_relaxed);
+    }
+
+    // Stops at the given instant.
+    void set_deadline(clock::time_point when) {
+        deadline.store(when.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    // Stops after the given number of seconds from now (immediately if not positive).
+    void set_timeout(double seconds) {
+        if (!(seconds < max_timeout_sec)) {
+            deadline.store(no_deadline, std::memory_order_relaxed);
+            return;
+        }
+        auto timeout = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(seconds > 0.0 ? seconds : 0.0));
+        set_deadline(clock::now() + timeout);
+    }
+
+    // Clears both the stop request and the deadline, so that the token can be reused.
+    void reset() {
+        stop_flag.store(false, std::memory_order_relaxed);
+        deadline.store(no_deadline, std::memory_order_relaxed);
+    }
+
+    bool stop_requested() const {
+        if (stop_flag.load(std::memory_order_relaxed))
+            return true;
+        int64_t when = deadline.load(std::memory_order_relaxed);
+        return when != no_deadline && clock::now().time_since_epoch().count() >= when;
+    }
+};
+
+}  // namespace cft
+
+
+#endif /* CFT_SRC_CORE_STOPTOKEN_HPP */
@@ -5,9 +5,13 @@
 #define CFT_SRC_CORE_CFT_HPP
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "core/Profile.hpp"
+#include "core/StopToken.hpp"
 #include "utils/Chrono.hpp"
 #include "utils/assert.hpp"  // IWYU pragma:  keep
 #include "utils/custom_types.hpp"
@@ -22,10 +26,11 @@
 #endif
 
 // AVAILABLE PARSERS
-#define CFT_RAIL_PARSER "RAIL"
-#define CFT_SCP_PARSER  "SCP"
-#define CFT_CVRP_PARSER "CVRP"
-#define CFT_MPS_PARSER  "MPS"
+#define CFT_RAIL_PARSER   "RAIL"
+#define CFT_SCP_PARSER    "SCP"
+#define CFT_CVRP_PARSER   "CVRP"
+#define CFT_MPS_PARSER    "MPS"
+#define CFT_BINARY_PARSER "BINARY"
 
 #ifndef CFT_CIDX_TYPE
 #define CFT_CIDX_TYPE int32_t
@@ -115,15 +120,24 @@ struct Solution {
 
 // Dual solution for the Set Covering problem
 struct DualState {
-    std::vector<real_t> mults;  // Lagrangian multipliers
-    real_t              lb;     // Lower bound
+    std::vector<real_t> mults;      // Lagrangian multipliers
+    real_t              lb;         // Lower bound
+    std::vector<cidx_t> core_cols;  // Core instance columns when mults were found
+    real_t              step_size;  // Subgradient step size when mults were found
 };
 
 struct CftResult {
     Solution  sol;
     DualState dual;
+    double    sol_time;  // env.timer seconds when run() found sol (0 for the warmstart)
+    Profile   profile;   // Per-component timings of the run
 };
 
+class IncumbentNotifier;
+
+// Called with each improving solution, the current lower bound and the elapsed env.timer seconds
+using IncumbentCallback = std::function<void(Solution const&, real_t, double)>;
+
 // Environment struct to hold all the parameters and working variables
 struct Environment {
     // Cli params
@@ -141,10 +155,26 @@ struct Environment {
     real_t      abs_subgrad_exit = 1.0_F;    // Minimum LBs delta to trigger subradient termination
     real_t      rel_subgrad_exit = 0.001_F;  // Minimum LBs gap to trigger subradient termination
     bool        use_unit_costs   = false;    // Solve the given instance setting columns cost to one
-
-    // Working params
-    Chrono<>       timer;            // Keeps track of the elapsed time
-    mutable prng_t rnd = prng_t(0);  // Random number generator
+    bool        use_mmap         = false;    // Memory-map the instance file while parsing
+    uint64_t    nthreads         = 1;        // Number of worker threads
+    uint64_t    portfolio        = 1;        // Number of concurrent runs sharing the incumbent
+    uint64_t    red_costs_period = 32;       // Full reduced costs period, 1 = no live updates
+    uint64_t    enum_vars        = 24;       // Redundant columns left to enumerate (at most 64)
+    uint64_t    enum_nodes       = 16384;    // Node budget of the redundant columns enumeration
+    std::string convert_path;     // If set, only write the instance in binary format here
+    std::string profile_path;     // If set, write the per-component timings (JSON or CSV) here
+    std::string checkpoint_path;  // If set, warm start from this file (if any), then update it
+
+    // Run control, from other threads too
+    IncumbentCallback          on_incumbent;  // If set, streams improving solutions
+    std::shared_ptr<StopToken> stop_token;    // If set, the run also stops when this token says so
+
+    // Working params. run() works on its own copy of the Environment, so the mutable ones are never
+    // written to the caller's one and concurrent runs can share it.
+    Chrono<>           timer;                 // Keeps track of the elapsed time
+    mutable prng_t     rnd      = prng_t(0);  // Random number generator
+    mutable Profile    profile;               // Per-component timings, returned by run()
+    IncumbentNotifier* notifier = nullptr;    // Set by run() while on_incumbent is in use
 
 
     real_t min_fixing = 0.3_F;
@@ -168,6 +198,13 @@ struct Environment {
     // uint64_t    c2_price_cov             = 5;
 };
 
+// True if the run should stop: time limit reached or stop requested through env.stop_token. Cheap
+// enough to be polled at every iteration of the inner loops.
+inline bool stop_requested(Environment const& env) {
+    return env.timer.elapsed<sec>() > env.time_limit ||
+           (env.stop_token != nullptr && env.stop_token->stop_requested());
+}
+
 }  // namespace cft
 
 
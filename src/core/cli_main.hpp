@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef CFT_SRC_CORE_CLI_MAIN_HPP
+#define CFT_SRC_CORE_CLI_MAIN_HPP
+
+
+#include <cstdlib>
+#include <fstream>
+
+#include "algorithms/Refinement.hpp"
+#include "core/CliArgs.hpp"
+#include "core/cft.hpp"
+#include "core/parsing.hpp"
+#include "utils/print.hpp"
+
+namespace cft {
+
+// Command line solver: parses the arguments and the instance, runs the algorithm and writes the
+// solution. The timer starts at `start`. Errors are reported through exceptions, RowIndexOverflow
+// if the instance has too many rows for this instantiation: `rerun` marks the second attempt with
+// wider row indexes, which keeps the same start and does not print the banner again.
+inline int cli_main(int argc, char const** argv, Chrono<>::time_point start, bool rerun = false) {
+    auto env        = parse_cli_args(argc, argv);
+    env.timer.start = start;
+
+    if (!rerun) {
+        print<1>(env, "CFT implementation by Luca Accorsi and Francesco Cavaliere.\n");
+        print<2>(env, "Compiled on " __DATE__ " at " __TIME__ ".\n\n");
+        print<3>(env, "Running with parameters set to:\n");
+        print_arg_values(env);
+    }
+
+    auto fdata = parse_inst_and_initsol(env);
+    if (!env.convert_path.empty()) {
+        write_binary_instance(env.convert_path, fdata);
+        print<1>(env, "CFT> Binary instance written to {}\n", env.convert_path);
+        return EXIT_SUCCESS;
+    }
+
+    auto warm = CftResult();
+    if (!env.checkpoint_path.empty() && std::ifstream(env.checkpoint_path).good()) {
+        warm = parse_checkpoint(env.checkpoint_path);
+        fit_checkpoint(fdata.inst, warm);
+        print<1>(env,
+                 "CFT> Warm start from {}: {} multipliers, solution {:.2f}\n",
+                 env.checkpoint_path,
+                 warm.dual.mults.size(),
+                 warm.sol.idxs.empty() ? limits<real_t>::max() : warm.sol.cost);
+        bool const better_sol = fdata.init_sol.idxs.empty() || warm.sol.cost < fdata.init_sol.cost;
+        if (!warm.sol.idxs.empty() && better_sol)
+            fdata.init_sol = warm.sol;
+    }
+
+    auto res = run(env, fdata.inst, fdata.init_sol, warm.dual);
+    write_solution(env.sol_path, res.sol);
+    if (!env.checkpoint_path.empty())
+        write_checkpoint(env.checkpoint_path, res);
+    print<1>(env,
+             "CFT> Best solution {:.2f} time {:.2f}s\n",
+             res.sol.cost,
+             env.timer.elapsed<sec>());
+    return EXIT_SUCCESS;
+}
+
+}  // namespace cft
+
+
+#endif /* CFT_SRC_CORE_CLI_MAIN_HPP */
@@ -6,16 +6,23 @@
 
 #include <fmt/ostream.h>
 
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <stdexcept>
-#include <unordered_map>
 #include <vector>
 
 #include "core/Instance.hpp"
 #include "core/cft.hpp"
+#include "utils/CoverCounters.hpp"
 #include "utils/SparseBinMat.hpp"
+#include "utils/StringMap.hpp"
 #include "utils/StringView.hpp"
 #include "utils/assert.hpp"  // IWYU pragma:  keep
 #include "utils/limits.hpp"
+#include "utils/parallel.hpp"
 #include "utils/parse_utils.hpp"
 #include "utils/print.hpp"
 
@@ -25,35 +32,247 @@
 
 namespace cft {
 
+// Thrown when an instance is too large for the index types in use (see CFT_RIDX_TYPE and
+// CFT_CIDX_TYPE), e.g., more than 32767 rows with the default 16-bit row indexes.
+struct IndexOverflow : std::out_of_range {
+    using std::out_of_range::out_of_range;
+};
+
+// IndexOverflow caused by the rows alone, which a build with wider row indexes can handle.
+struct RowIndexOverflow : IndexOverflow {
+    using IndexOverflow::IndexOverflow;
+};
+
+// Parsing modes for text instance formats. StreamParsing reads the file one line at a time through
+// std::ifstream and converts numbers with strtol & co. MmapParsing maps the whole file in memory
+// and scans numbers in place, without copies or allocations.
+struct StreamParsing {
+    using line_iterator = FileLineIterator;
+};
+
+struct MmapParsing {
+    using line_iterator = MappedLineIterator;
+};
+
+// Multi-threaded parsing mode for the formats storing one column per line (RAIL and CVRP). The file
+// is memory-mapped and split in one range of whole lines per thread, each thread parses its range
+// into a local fragment, and the fragments are finally concatenated in order.
+struct ParallelParsing {
+    size_t nthreads;
+
+    explicit ParallelParsing(size_t nthr)
+        : nthreads(cft::max(nthr, size_t{1})) {
+    }
+};
+
 namespace local { namespace {
     struct InstSize {
         ridx_t rows;
         cidx_t cols;
     };
 
-    InstSize read_nrows_and_ncols(FileLineIterator& file_iter) {
+    template <typename T>
+    T consume(StreamParsing /*mode*/, StringView& line_view) {
+        return string_to<T>::consume(line_view);
+    }
+
+    template <typename T>
+    T consume(MmapParsing /*mode*/, StringView& line_view) {
+        return fast_string_to<T>::consume(line_view);
+    }
+
+    // Converts an instance size to the given index type, throws OverflowT if it does not fit.
+    template <typename IdxT, typename OverflowT>
+    IdxT checked_inst_size(int64_t size, char const* what) {
+        if (size < 0)
+            throw std::invalid_argument("Invalid file format: negative instance size.");
+        if (static_cast<uint64_t>(size) > static_cast<uint64_t>(native_cast(limits<IdxT>::max())))
+            throw OverflowT(fmt::format("{} {} do not fit {}-bit indexes",
+                                        size,
+                                        what,
+                                        sizeof(IdxT) * CHAR_BIT));
+        return checked_cast<IdxT>(size);
+    }
+
+    template <typename ModeT>
+    InstSize read_nrows_and_ncols(ModeT mode, typename ModeT::line_iterator& file_iter) {
         auto line_view = file_iter.next();
-        auto num       = InstSize();
-        num.rows       = string_to<ridx_t>::consume(line_view);
-        num.cols       = string_to<cidx_t>::consume(line_view);
+        auto nrows     = consume<int64_t>(mode, line_view);
+        auto ncols     = consume<int64_t>(mode, line_view);
         if (!line_view.empty())
             throw std::invalid_argument("Invalid file format: too many values in the first line.");
+        auto num = InstSize();
+        num.cols = checked_inst_size<cidx_t, IndexOverflow>(ncols, "columns");  // Checked first
+        num.rows = checked_inst_size<ridx_t, RowIndexOverflow>(nrows, "rows");
         return num;
     }
 
+    // Parses a RAIL column line: cost, number of rows, list of (1-based) row indexes
+    template <typename ModeT>
+    void parse_rail_col(ModeT                 mode,       // in
+                        StringView            line_view,  // in
+                        ridx_t                nrows,      // in
+                        SparseBinMat<ridx_t>& cols,       // inout
+                        std::vector<real_t>&  costs       // inout
+    ) {
+        costs.push_back(consume<real_t>(mode, line_view));
+        auto j_nrows = consume<ridx_t>(mode, line_view);
+        for (ridx_t n = 0_R; n < j_nrows; n++) {
+            if (line_view.empty())
+                throw std::invalid_argument("Invalid file format: not a RAIL instance?");
+            cols.idxs.push_back(consume<ridx_t>(mode, line_view) - 1_R);
+            if (cols.idxs.back() >= nrows)
+                throw std::invalid_argument("Invalid file format: not a RAIL instance?");
+        }
+        if (!line_view.empty())
+            throw std::invalid_argument("Invalid file format: not a RAIL instance?");
+        cols.begs.push_back(cols.idxs.size());
+    }
+
+    // Parses a CVRP column line: cost, solution cost, list of (0-based) row indexes
+    template <typename ModeT>
+    void parse_cvrp_col(ModeT                 mode,       // in
+                        StringView            line_view,  // in
+                        ridx_t                nrows,      // in
+                        SparseBinMat<ridx_t>& cols,       // inout
+                        std::vector<real_t>&  costs       // inout
+    ) {
+        costs.push_back(consume<real_t>(mode, line_view));
+        real_t solcost = consume<real_t>(mode, line_view);
+        if (solcost < costs.back())
+            throw std::invalid_argument("Invalid file format: not a CVRP instance?");
+
+        while (!line_view.empty()) {
+            cols.idxs.push_back(consume<ridx_t>(mode, line_view));
+            if (cols.idxs.back() >= nrows)
+                throw std::invalid_argument("Invalid file format: not a CVRP instance?");
+        }
+        cols.begs.push_back(cols.idxs.size());
+    }
+
+    // Parses the CVRP line following the columns, listing the columns of an initial solution
+    template <typename ModeT>
+    void parse_cvrp_solution(ModeT                      mode,       // in
+                             StringView                 line_view,  // in
+                             std::vector<real_t> const& costs,      // in
+                             Solution&                  sol         // out
+    ) {
+        while (!line_view.empty()) {
+            cidx_t j = consume<cidx_t>(mode, line_view);
+            sol.idxs.push_back(j);
+            sol.cost += costs[j];
+        }
+    }
+
+    // Columns parsed by a single thread from its range of lines
+    struct ColsFragment {
+        SparseBinMat<ridx_t> cols;
+        std::vector<real_t>  costs;
+        StringView           next_line;              // First line after the column ones ...
+        bool                 has_next_line = false;  // ... if it belongs to this range
+    };
+
+    // Text of the file not yet consumed by the iterator
+    inline StringView remaining_text(MappedLineIterator const& file_iter) {
+        return {file_iter.pos, file_iter.file.data() + file_iter.file.size()};
+    }
+
+    // Splits text in nchunks contiguous ranges, each one starting at the beginning of a line
+    inline std::vector<StringView> split_at_lines(StringView text, size_t nchunks) {
+        auto        chunks = std::vector<StringView>();
+        char const* beg    = text.begin();
+        for (size_t c = 1; c < nchunks; ++c) {
+            char const* end = text.begin() + text.size() * c / nchunks;
+            end             = end < beg ? beg : end;
+            auto const* nl  = static_cast<char const*>(
+                std::memchr(end, '\n', checked_cast<size_t>(text.end() - end)));
+            end = nl == nullptr ? text.end() : nl + 1;
+            chunks.emplace_back(beg, end);
+            beg = end;
+        }
+        chunks.emplace_back(beg, text.end());
+        return chunks;
+    }
+
+    // Parses in parallel the first ncols lines of text, one column per line, with
+    // parse_col(line_view, fragment). Lines are numbered before parsing (a fast newline count per
+    // range and a prefix sum), so each thread knows which of its lines are columns.
+    template <typename ParseColFn>
+    std::vector<ColsFragment> parse_col_lines(StringView text,
+                                              cidx_t     ncols,
+                                              size_t     nthreads,
+                                              ParseColFn parse_col) {
+        auto chunks     = split_at_lines(text, nthreads);
+        auto first_line = std::vector<size_t>(nthreads + 1, 0);
+        parallel_run(nthreads, [&](size_t t) {
+            first_line[t + 1] = checked_cast<size_t>(
+                std::count(chunks[t].begin(), chunks[t].end(), '\n'));
+        });
+        for (size_t t = 0; t < nthreads; ++t)
+            first_line[t + 1] += first_line[t];
+
+        auto fragments = std::vector<ColsFragment>(nthreads);
+        auto last_line = checked_cast<size_t>(ncols);
+        parallel_run(nthreads, [&](size_t t) {
+            char const* pos = chunks[t].begin();
+            char const* end = chunks[t].end();
+            for (size_t l = first_line[t]; pos != end && l <= last_line; ++l) {
+                auto const* nl = static_cast<char const*>(
+                    std::memchr(pos, '\n', checked_cast<size_t>(end - pos)));
+                auto line_view = trim(StringView(pos, nl == nullptr ? end : nl));
+                pos            = nl == nullptr ? end : nl + 1;
+
+                if (l < last_line)
+                    parse_col(line_view, fragments[t]);
+                else {
+                    fragments[t].next_line     = line_view;
+                    fragments[t].has_next_line = true;
+                }
+            }
+        });
+        return fragments;
+    }
+
+    // Concatenates the fragments in order, shifting each fragment begs by the number of indexes
+    // that precede it (i.e., a prefix sum over the fragments sizes). Thread t copies fragment t.
+    inline void merge_fragments(std::vector<ColsFragment> const& fragments,  // in
+                                SparseBinMat<ridx_t>&            cols,       // out
+                                std::vector<real_t>&             costs       // out
+    ) {
+        auto col_offs = std::vector<size_t>(fragments.size() + 1, 0);
+        auto idx_offs = std::vector<size_t>(fragments.size() + 1, 0);
+        for (size_t t = 0; t < fragments.size(); ++t) {
+            col_offs[t + 1] = col_offs[t] + fragments[t].cols.size();
+            idx_offs[t + 1] = idx_offs[t] + fragments[t].cols.idxs.size();
+        }
+
+        cols.idxs.resize(idx_offs.back());
+        cols.begs.assign(col_offs.back() + 1, 0);
+        costs.resize(col_offs.back());
+        parallel_run(fragments.size(), [&](size_t t) {
+            auto const& frag = fragments[t];
+            std::copy(frag.cols.idxs.begin(),
+                      frag.cols.idxs.end(),
+                      cols.idxs.begin() + checked_cast<ptrdiff_t>(idx_offs[t]));
+            std::copy(frag.costs.begin(),
+                      frag.costs.end(),
+                      costs.begin() + checked_cast<ptrdiff_t>(col_offs[t]));
+            for (size_t k = 1; k < frag.cols.begs.size(); ++k)
+                cols.begs[col_offs[t] + k] = frag.cols.begs[k] + idx_offs[t];
+        });
+    }
+
 #ifndef NDEBUG
-    inline void mps_epilogue_check(FileLineIterator&                              file_iter,
-                                   std::unordered_map<std::string, ridx_t> const& rows_map) {
+    template <typename LineIterT>
+    void mps_epilogue_check(LineIterT& file_iter, StringMap<ridx_t> const& rows_map) {
         // Check RHSs
         auto line_view = file_iter.next();
         while (line_view != "BOUNDS") {
-            line_view   = trim(line_view);
             auto tokens = split(line_view);
             assert(tokens[0] == "rhs" || tokens[0] == "RHS");
 
             for (size_t t = 1; t < tokens.size(); t += 2) {
-                auto row_name = tokens[t];
-                assert(rows_map.find(row_name.to_cpp_string()) != rows_map.end());
+                assert(rows_map.find(tokens[t]) != nullptr);
                 assert(tokens[t + 1] == "1" || tokens[t + 1] == "-1");
             }
 
@@ -64,16 +283,17 @@ namespace local { namespace {
 }  // namespace
 }  // namespace local
 
-inline Instance parse_scp_instance(std::string const& path) {
-    auto file_iter = FileLineIterator(path);
-    auto num       = local::read_nrows_and_ncols(file_iter);
+template <typename ModeT = StreamParsing>
+Instance parse_scp_instance(std::string const& path, ModeT mode = {}) {
+    auto file_iter = typename ModeT::line_iterator(path);
+    auto num       = local::read_nrows_and_ncols(mode, file_iter);
 
     auto line_view = StringView();
     auto inst      = Instance();
     for (cidx_t j = 0_C; j < num.cols; ++j) {
         if (line_view.empty())
             line_view = file_iter.next();
-        inst.costs.push_back(string_to<real_t>::consume(line_view));
+        inst.costs.push_back(local::consume<real_t>(mode, line_view));
     }
 
     // For each row: row_size
@@ -81,14 +301,14 @@ inline Instance parse_scp_instance(std::string const& path) {
     auto cols = std::vector<std::vector<ridx_t>>(num.cols);
     for (ridx_t i = 0_R; i < num.rows; ++i) {
         line_view    = file_iter.next();
-        auto i_ncols = string_to<cidx_t>::consume(line_view);
+        auto i_ncols = local::consume<cidx_t>(mode, line_view);
         if (!line_view.empty())
             throw std::invalid_argument("Invalid file format: not a SCP instance?");
 
         for (cidx_t n = 0_C; n < i_ncols; ++n) {
             if (line_view.empty())
                 line_view = file_iter.next();
-            cidx_t cidx = string_to<cidx_t>::consume(line_view);
+            cidx_t cidx = local::consume<cidx_t>(mode, line_view);
             assert(0_C < cidx && cidx <= num.cols);
             if (cidx <= 0_C || num.cols < cidx)
                 throw std::invalid_argument("Invalid column index: not a SCP instance?");
@@ -110,74 +330,93 @@ inline Instance parse_scp_instance(std::string const& path) {
     return inst;
 }
 
-inline Instance parse_rail_instance(std::string const& path) {
-    auto file_iter = FileLineIterator(path);
-    auto num       = local::read_nrows_and_ncols(file_iter);
+struct FileData {
+    Instance inst;
+    Solution init_sol;
+};
 
-    auto line_view = StringView();
-    auto inst      = Instance();
-    for (cidx_t j = 0_C; j < num.cols; j++) {
-        line_view = file_iter.next();
-        inst.costs.push_back(string_to<real_t>::consume(line_view));
-        auto j_nrows = string_to<ridx_t>::consume(line_view);
-        auto tokens  = split(line_view);
-        if (rsize(tokens) != j_nrows)
-            throw std::invalid_argument("Invalid file format: not a RAIL instance?");
+template <typename ModeT = StreamParsing>
+Instance parse_rail_instance(std::string const& path, ModeT mode = {}) {
+    auto file_iter = typename ModeT::line_iterator(path);
+    auto num       = local::read_nrows_and_ncols(mode, file_iter);
 
-        for (ridx_t n = 0_R; n < j_nrows; n++) {
-            inst.cols.idxs.push_back(string_to<ridx_t>::parse(tokens[n]) - 1_R);
-            if (inst.cols.idxs.back() >= num.rows)
-                throw std::invalid_argument("Invalid file format: not a RAIL instance?");
-        }
-        inst.cols.begs.push_back(csize(inst.cols.idxs));
-    }
+    auto inst = Instance();
+    for (cidx_t j = 0_C; j < num.cols; j++)
+        local::parse_rail_col(mode, file_iter.next(), num.rows, inst.cols, inst.costs);
 
     fill_rows_from_cols(inst.cols, num.rows, inst.rows);
     return inst;
 }
 
-struct FileData {
-    Instance inst;
-    Solution init_sol;
-};
+inline Instance parse_rail_instance(std::string const& path, ParallelParsing mode) {
+    auto file_iter = MappedLineIterator(path);
+    auto num       = local::read_nrows_and_ncols(MmapParsing{}, file_iter);
+    auto nrows     = num.rows;
 
-inline FileData parse_cvrp_instance(std::string const& path) {
-    auto file_iter = FileLineIterator(path);
-    auto num       = local::read_nrows_and_ncols(file_iter);
+    auto fragments = local::parse_col_lines(
+        local::remaining_text(file_iter),
+        num.cols,
+        mode.nthreads,
+        [nrows](StringView line_view, local::ColsFragment& frag) {
+            local::parse_rail_col(MmapParsing{}, line_view, nrows, frag.cols, frag.costs);
+        });
 
-    auto line_view = StringView();
-    auto fdata     = FileData();
-    for (cidx_t j = 0_C; j < num.cols; j++) {
-        line_view = file_iter.next();
-        fdata.inst.costs.push_back(string_to<real_t>::consume(line_view));
+    auto inst = Instance();
+    local::merge_fragments(fragments, inst.cols, inst.costs);
+    if (csize(inst.cols) != num.cols)
+        throw std::invalid_argument("Invalid file format: not a RAIL instance?");
 
-        real_t solcost = string_to<real_t>::consume(line_view);
-        if (solcost < fdata.inst.costs.back())
-            throw std::invalid_argument("Invalid file format: not a CVRP instance?");
+    fill_rows_from_cols(inst.cols, num.rows, inst.rows);
+    return inst;
+}
 
-        while (!line_view.empty()) {
-            fdata.inst.cols.idxs.push_back(string_to<ridx_t>::consume(line_view));
-            if (fdata.inst.cols.idxs.back() >= num.rows)
-                throw std::invalid_argument("Invalid file format: not a CVRP instance?");
-        }
-        fdata.inst.cols.begs.push_back(csize(fdata.inst.cols.idxs));
-    }
+template <typename ModeT = StreamParsing>
+FileData parse_cvrp_instance(std::string const& path, ModeT mode = {}) {
+    auto file_iter = typename ModeT::line_iterator(path);
+    auto num       = local::read_nrows_and_ncols(mode, file_iter);
 
-    line_view = file_iter.next();
-    while (!line_view.empty()) {
-        cidx_t j = string_to<cidx_t>::consume(line_view);
-        fdata.init_sol.idxs.push_back(j);
-        fdata.init_sol.cost += fdata.inst.costs[j];
-    }
+    auto fdata = FileData();
+    for (cidx_t j = 0_C; j < num.cols; j++)
+        local::parse_cvrp_col(mode, file_iter.next(), num.rows, fdata.inst.cols, fdata.inst.costs);
+
+    local::parse_cvrp_solution(mode, file_iter.next(), fdata.inst.costs, fdata.init_sol);
+    fill_rows_from_cols(fdata.inst.cols, num.rows, fdata.inst.rows);
+    return fdata;
+}
+
+inline FileData parse_cvrp_instance(std::string const& path, ParallelParsing mode) {
+    auto file_iter = MappedLineIterator(path);
+    auto num       = local::read_nrows_and_ncols(MmapParsing{}, file_iter);
+    auto nrows     = num.rows;
+
+    auto fragments = local::parse_col_lines(
+        local::remaining_text(file_iter),
+        num.cols,
+        mode.nthreads,
+        [nrows](StringView line_view, local::ColsFragment& frag) {
+            local::parse_cvrp_col(MmapParsing{}, line_view, nrows, frag.cols, frag.costs);
+        });
+
+    auto fdata = FileData();
+    local::merge_fragments(fragments, fdata.inst.cols, fdata.inst.costs);
+    if (csize(fdata.inst.cols) != num.cols)
+        throw std::invalid_argument("Invalid file format: not a CVRP instance?");
+
+    for (auto const& frag : fragments)
+        if (frag.has_next_line)
+            local::parse_cvrp_solution(
+                MmapParsing{}, frag.next_line, fdata.inst.costs, fdata.init_sol);
 
     fill_rows_from_cols(fdata.inst.cols, num.rows, fdata.inst.rows);
     return fdata;
 }
 
 // Note: not a complete mps parser, best effort to parse a SCP instance, but can probably fail with
-// some formats, or parse non SCP instances as SCP.
-inline Instance parse_mps_instance(std::string const& path) {
-    auto file_iter = FileLineIterator(path);
+// some formats, or parse non SCP instances as SCP. Lines are tokenized in place and row names are
+// looked up with StringView keys, so nothing is allocated per line or per nonzero.
+template <typename ModeT = StreamParsing>
+Instance parse_mps_instance(std::string const& path, ModeT mode = {}) {
+    auto file_iter = typename ModeT::line_iterator(path);
     auto inst      = Instance();
 
     auto   line_view    = file_iter.next();
@@ -188,14 +427,19 @@ inline Instance parse_mps_instance(std::string const& path) {
         throw std::invalid_argument("Invalid file format: not a MPS instance?");
 
     ridx_t nrows    = 0_R;
-    auto   rows_map = std::unordered_map<std::string, ridx_t>();
+    auto   rows_map = StringMap<ridx_t>();
     auto   obj_name = std::string();
     while (line_view != "COLUMNS") {
-        auto tokens = split(line_view);
-        if (!tokens.empty() && tokens[0] == "N")
-            obj_name = tokens[1].to_cpp_string();
-        if (!tokens.empty() && (tokens[0] == "G" || tokens[0] == "E" || tokens[0] == "L"))
-            rows_map[tokens[1].to_cpp_string()] = nrows++;
+        auto type = consume_token(line_view);
+        auto name = consume_token(line_view);
+        if (type == "N")
+            obj_name = name.to_cpp_string();
+        if (type == "G" || type == "E" || type == "L") {
+            if (nrows == limits<ridx_t>::max())
+                throw RowIndexOverflow("MPS rows do not fit the row index type");
+            if (!rows_map.insert(name, nrows++))
+                throw std::invalid_argument("Invalid file format: duplicated MPS row name.");
+        }
         line_view = file_iter.next();
     }
 
@@ -203,28 +447,36 @@ inline Instance parse_mps_instance(std::string const& path) {
     line_view          = file_iter.next();
     inst.cols.begs.clear();
     while (line_view != "RHS") {
-        auto tokens = split(line_view);
+        auto col_name = consume_token(line_view);
+
         // Best effort to detect columns header line
-        if (tokens.size() < 3 || (std::isdigit(tokens[2][0]) == 0 && tokens[2][0] != '-')) {
+        auto first_pair = line_view;
+        consume_token(first_pair);
+        auto first_val = consume_token(first_pair);
+        if (first_val.empty() || (std::isdigit(first_val[0]) == 0 && first_val[0] != '-')) {
             line_view = file_iter.next();
             continue;
         }
 
-        if (tokens[0] != prev_col_name) {  // new column
-            prev_col_name = tokens[0].to_cpp_string();
+        if (col_name != prev_col_name) {  // new column
+            prev_col_name.assign(col_name.begin(), col_name.end());
             inst.cols.begs.push_back(csize(inst.cols.idxs));
             inst.costs.push_back(limits<real_t>::max());
         }
 
-        for (size_t t = 1; t < tokens.size(); t += 2) {
-            if (tokens[t] == obj_name)
-                inst.costs.back() = string_to<real_t>::parse(tokens[t + 1]);
-            else {
-                auto row_name = tokens[t];
-                assert(rows_map.find(row_name.to_cpp_string()) != rows_map.end());
-                assert(tokens[t + 1] == "1" || tokens[t + 1] == "-1");
-                inst.cols.idxs.push_back(rows_map[row_name.to_cpp_string()]);
+        while (!line_view.empty()) {
+            auto row_name = consume_token(line_view);
+            auto value    = consume_token(line_view);
+            if (row_name == obj_name) {
+                inst.costs.back() = local::consume<real_t>(mode, value);
+                continue;
             }
+
+            auto const* i = rows_map.find(row_name);
+            if (i == nullptr)
+                throw std::invalid_argument("Invalid file format: unknown MPS row name.");
+            assert(value == "1" || value == "-1");
+            inst.cols.idxs.push_back(*i);
         }
 
         line_view = file_iter.next();
@@ -258,24 +510,355 @@ inline void write_solution(std::string const& path, Solution const& sol) {
     file.close();
 }
 
+// Binary instance format (.cftb). Meant to skip text parsing when the same instance is solved many
+// times. Little-endian layout, every section starts at a multiple of 8 bytes:
+//   BinaryHeader
+//   cols.begs  : uint64_t[ncols + 1]
+//   cols.idxs  : ridx_t[nnz]
+//   costs      : real_t[ncols]
+//   rows.begs  : uint64_t[nrows + 1]  (only if CFT_BINARY_HAS_ROWS)
+//   rows.idxs  : cidx_t[nnz]          (only if CFT_BINARY_HAS_ROWS)
+//   sol.idxs   : cidx_t[sol_size]     (only if CFT_BINARY_HAS_SOL)
+//   sol.cost   : real_t               (only if CFT_BINARY_HAS_SOL)
+// Index and real types are stored as they are, so a file can only be loaded by a build using types
+// of the same width.
+#define CFT_BINARY_VERSION  1
+#define CFT_BINARY_HAS_ROWS 1U
+#define CFT_BINARY_HAS_SOL  2U
+
+struct BinaryHeader {
+    char     magic[4];   // "CFTB"
+    uint32_t version;    // CFT_BINARY_VERSION
+    uint8_t  cidx_size;  // sizeof(cidx_t)
+    uint8_t  ridx_size;  // sizeof(ridx_t)
+    uint8_t  real_size;  // sizeof(real_t)
+    uint8_t  flags;      // CFT_BINARY_HAS_* bits
+    uint32_t reserved;   // Zero
+    uint64_t nrows;
+    uint64_t ncols;
+    uint64_t nnz;
+    uint64_t sol_size;
+};
+
+namespace local { namespace {
+    // Sections are dumped as they are in memory, begs included (hence size_t must be 64 bits)
+    inline bool binary_format_supported() {
+        uint32_t probe = 1;
+        char     first = 0;
+        std::memcpy(&first, &probe, 1);
+        return first == 1 && sizeof(size_t) == sizeof(uint64_t);
+    }
+
+    inline size_t padded_size(size_t bytes) {
+        return (bytes + 7U) & ~size_t{7U};
+    }
+
+    template <typename T>
+    void write_section(std::ofstream& out, std::vector<T> const& vec) {
+        static constexpr char zeros[8] = {};
+        size_t                bytes    = vec.size() * sizeof(T);
+        out.write(reinterpret_cast<char const*>(vec.data()), checked_cast<std::streamsize>(bytes));
+        out.write(zeros, checked_cast<std::streamsize>(padded_size(bytes) - bytes));
+    }
+
+    // Copies a section out of the mapped file and advances the read position
+    template <typename T>
+    void read_section(char const*& pos, size_t count, std::vector<T>& vec) {
+        vec.resize(count);
+        size_t bytes = count * sizeof(T);
+        if (bytes > 0)
+            std::memcpy(vec.data(), pos, bytes);
+        pos += padded_size(bytes);
+    }
+
+    inline void check_binary_begs(std::vector<size_t> const& begs, size_t nnz) {
+        for (size_t k = 1; k < begs.size(); ++k)
+            if (begs[k] < begs[k - 1])
+                throw std::invalid_argument("Invalid binary file: corrupted begs section.");
+        if (begs.front() != 0 || begs.back() != nnz)
+            throw std::invalid_argument("Invalid binary file: corrupted begs section.");
+    }
+}  // namespace
+}  // namespace local
+
+inline void write_binary_instance(std::string const& path, FileData const& fdata) {
+    if (!local::binary_format_supported())
+        throw std::runtime_error("Binary instances require a 64-bit little-endian host.");
+
+    auto const& inst = fdata.inst;
+    auto        hdr  = BinaryHeader();
+    std::memcpy(hdr.magic, "CFTB", 4);
+    hdr.version   = CFT_BINARY_VERSION;
+    hdr.cidx_size = sizeof(cidx_t);
+    hdr.ridx_size = sizeof(ridx_t);
+    hdr.real_size = sizeof(real_t);
+    hdr.flags     = static_cast<uint8_t>(CFT_BINARY_HAS_ROWS |
+                                     (fdata.init_sol.idxs.empty() ? 0U : CFT_BINARY_HAS_SOL));
+    hdr.nrows     = inst.rows.size();
+    hdr.ncols     = inst.cols.size();
+    hdr.nnz       = inst.cols.idxs.size();
+    hdr.sol_size  = fdata.init_sol.idxs.size();
+
+    auto out = std::ofstream(path, std::ios::binary);
+    if (!out.is_open())
+        throw std::runtime_error("Failed to open file for writing: " + path);
+    out.write(reinterpret_cast<char const*>(&hdr), sizeof(hdr));
+    local::write_section(out, inst.cols.begs);
+    local::write_section(out, inst.cols.idxs);
+    local::write_section(out, inst.costs);
+    local::write_section(out, inst.rows.begs);
+    local::write_section(out, inst.rows.idxs);
+    if ((hdr.flags & CFT_BINARY_HAS_SOL) != 0U) {
+        local::write_section(out, fdata.init_sol.idxs);
+        local::write_section(out, std::vector<real_t>{fdata.init_sol.cost});
+    }
+    if (!out)
+        throw std::runtime_error("Failed to write binary instance: " + path);
+}
+
+inline FileData parse_binary_instance(std::string const& path) {
+    if (!local::binary_format_supported())
+        throw std::runtime_error("Binary instances require a 64-bit little-endian host.");
+
+    auto file = MappedFile(path);
+    auto hdr  = BinaryHeader();
+    if (file.size() < sizeof(hdr) || std::memcmp(file.data(), "CFTB", 4) != 0)
+        throw std::invalid_argument("Invalid file format: not a CFT binary instance?");
+    std::memcpy(&hdr, file.data(), sizeof(hdr));
+
+    if (hdr.version != CFT_BINARY_VERSION)
+        throw std::invalid_argument(
+            fmt::format("Unsupported binary instance version {} (expected {}).",
+                        hdr.version,
+                        CFT_BINARY_VERSION));
+    if (hdr.cidx_size == sizeof(cidx_t) && hdr.ridx_size > sizeof(ridx_t) &&
+        hdr.real_size == sizeof(real_t))
+        throw RowIndexOverflow(fmt::format("binary instance written with {}-bit row indexes",
+                                           hdr.ridx_size * CHAR_BIT));
+    if (hdr.cidx_size != sizeof(cidx_t) || hdr.ridx_size != sizeof(ridx_t) ||
+        hdr.real_size != sizeof(real_t))
+        throw std::invalid_argument(
+            fmt::format("Binary instance written with different types sizes: cidx {}, ridx {}, "
+                        "real {} (expected {}, {}, {}).",
+                        hdr.cidx_size,
+                        hdr.ridx_size,
+                        hdr.real_size,
+                        sizeof(cidx_t),
+                        sizeof(ridx_t),
+                        sizeof(real_t)));
+    if (hdr.nrows > file.size() || hdr.ncols > file.size() || hdr.nnz > file.size() ||
+        hdr.sol_size > file.size())
+        throw std::invalid_argument("Invalid binary file: sizes larger than the file itself.");
+    if (hdr.ncols > static_cast<uint64_t>(limits<cidx_t>::max()))
+        throw IndexOverflow("Binary instance columns do not fit the column index type.");
+    if (hdr.nrows > static_cast<uint64_t>(limits<ridx_t>::max()))
+        throw RowIndexOverflow("Binary instance rows do not fit the row index type.");
+
+    bool const has_rows = (hdr.flags & CFT_BINARY_HAS_ROWS) != 0U;
+    bool const has_sol  = (hdr.flags & CFT_BINARY_HAS_SOL) != 0U;
+    size_t     expected = sizeof(hdr) + local::padded_size((hdr.ncols + 1) * sizeof(size_t)) +
+                      local::padded_size(hdr.nnz * sizeof(ridx_t)) +
+                      local::padded_size(hdr.ncols * sizeof(real_t));
+    if (has_rows)
+        expected += local::padded_size((hdr.nrows + 1) * sizeof(size_t)) +
+                    local::padded_size(hdr.nnz * sizeof(cidx_t));
+    if (has_sol)
+        expected += local::padded_size(hdr.sol_size * sizeof(cidx_t)) +
+                    local::padded_size(sizeof(real_t));
+    if (file.size() != expected)
+        throw std::invalid_argument("Invalid binary file: unexpected file size.");
+
+    auto        fdata = FileData();
+    auto&       inst  = fdata.inst;
+    auto const  nrows = checked_cast<ridx_t>(hdr.nrows);
+    char const* pos   = file.data() + sizeof(hdr);
+    local::read_section(pos, hdr.ncols + 1, inst.cols.begs);
+    local::read_section(pos, hdr.nnz, inst.cols.idxs);
+    local::read_section(pos, hdr.ncols, inst.costs);
+    local::check_binary_begs(inst.cols.begs, hdr.nnz);
+    for (ridx_t i : inst.cols.idxs)
+        if (static_cast<uint64_t>(i) >= hdr.nrows)
+            throw std::invalid_argument("Invalid binary file: row index out of range.");
+
+    if (has_rows) {
+        local::read_section(pos, hdr.nrows + 1, inst.rows.begs);
+        local::read_section(pos, hdr.nnz, inst.rows.idxs);
+        local::check_binary_begs(inst.rows.begs, hdr.nnz);
+        for (cidx_t j : inst.rows.idxs)
+            if (static_cast<uint64_t>(j) >= hdr.ncols)
+                throw std::invalid_argument("Invalid binary file: column index out of range.");
+    } else
+        fill_rows_from_cols(inst.cols, nrows, inst.rows);
+
+    if (has_sol) {
+        auto sol_cost = std::vector<real_t>();
+        local::read_section(pos, hdr.sol_size, fdata.init_sol.idxs);
+        local::read_section(pos, 1, sol_cost);
+        fdata.init_sol.cost = sol_cost[0];
+        for (cidx_t j : fdata.init_sol.idxs)
+            if (static_cast<uint64_t>(j) >= hdr.ncols)
+                throw std::invalid_argument("Invalid binary file: solution column out of range.");
+    }
+    return fdata;
+}
+
+// Solver checkpoint (.cftk), the state needed to warm start a later run on the same (or a slightly
+// perturbed) instance. Same conventions of the binary instance format:
+//   CheckpointHeader
+//   scalars         : real_t[3]           (sol.cost, dual.lb, dual.step_size)
+//   dual.mults      : real_t[nrows]
+//   sol.idxs        : cidx_t[sol_size]
+//   dual.core_cols  : cidx_t[core_size]
+#define CFT_CHECKPOINT_VERSION 1
+
+struct CheckpointHeader {
+    char     magic[4];   // "CFTK"
+    uint32_t version;    // CFT_CHECKPOINT_VERSION
+    uint8_t  cidx_size;  // sizeof(cidx_t)
+    uint8_t  real_size;  // sizeof(real_t)
+    uint8_t  reserved[6];
+    uint64_t nrows;
+    uint64_t sol_size;
+    uint64_t core_size;
+};
+
+inline void write_checkpoint(std::string const& path, CftResult const& res) {
+    if (!local::binary_format_supported())
+        throw std::runtime_error("Checkpoints require a 64-bit little-endian host.");
+
+    auto hdr = CheckpointHeader();
+    std::memcpy(hdr.magic, "CFTK", 4);
+    hdr.version   = CFT_CHECKPOINT_VERSION;
+    hdr.cidx_size = sizeof(cidx_t);
+    hdr.real_size = sizeof(real_t);
+    hdr.nrows     = res.dual.mults.size();
+    hdr.sol_size  = res.sol.idxs.size();
+    hdr.core_size = res.dual.core_cols.size();
+
+    auto out = std::ofstream(path, std::ios::binary);
+    if (!out.is_open())
+        throw std::runtime_error("Failed to open file for writing: " + path);
+    out.write(reinterpret_cast<char const*>(&hdr), sizeof(hdr));
+    local::write_section(out, std::vector<real_t>{res.sol.cost, res.dual.lb, res.dual.step_size});
+    local::write_section(out, res.dual.mults);
+    local::write_section(out, res.sol.idxs);
+    local::write_section(out, res.dual.core_cols);
+    if (!out)
+        throw std::runtime_error("Failed to write checkpoint: " + path);
+}
+
+// Reads a checkpoint written by write_checkpoint. The content is only checked for consistency,
+// use fit_checkpoint to match it against an instance.
+inline CftResult parse_checkpoint(std::string const& path) {
+    if (!local::binary_format_supported())
+        throw std::runtime_error("Checkpoints require a 64-bit little-endian host.");
+
+    auto file = MappedFile(path);
+    auto hdr  = CheckpointHeader();
+    if (file.size() < sizeof(hdr) || std::memcmp(file.data(), "CFTK", 4) != 0)
+        throw std::invalid_argument("Invalid file format: not a CFT checkpoint?");
+    std::memcpy(&hdr, file.data(), sizeof(hdr));
+
+    if (hdr.version != CFT_CHECKPOINT_VERSION)
+        throw std::invalid_argument(fmt::format("Unsupported checkpoint version {} (expected {}).",
+                                                hdr.version,
+                                                CFT_CHECKPOINT_VERSION));
+    if (hdr.cidx_size != sizeof(cidx_t) || hdr.real_size != sizeof(real_t))
+        throw std::invalid_argument(
+            fmt::format("Checkpoint written with different types sizes: cidx {}, real {} "
+                        "(expected {}, {}).",
+                        hdr.cidx_size,
+                        hdr.real_size,
+                        sizeof(cidx_t),
+                        sizeof(real_t)));
+    if (hdr.nrows > file.size() || hdr.sol_size > file.size() || hdr.core_size > file.size())
+        throw std::invalid_argument("Invalid checkpoint: sizes larger than the file itself.");
+    size_t expected = sizeof(hdr) + local::padded_size(3 * sizeof(real_t)) +
+                      local::padded_size(hdr.nrows * sizeof(real_t)) +
+                      local::padded_size(hdr.sol_size * sizeof(cidx_t)) +
+                      local::padded_size(hdr.core_size * sizeof(cidx_t));
+    if (file.size() != expected)
+        throw std::invalid_argument("Invalid checkpoint: unexpected file size.");
+
+    auto        res     = CftResult();
+    auto        scalars = std::vector<real_t>();
+    char const* pos     = file.data() + sizeof(hdr);
+    local::read_section(pos, 3, scalars);
+    local::read_section(pos, hdr.nrows, res.dual.mults);
+    local::read_section(pos, hdr.sol_size, res.sol.idxs);
+    local::read_section(pos, hdr.core_size, res.dual.core_cols);
+    res.sol.cost       = scalars[0];
+    res.dual.lb        = scalars[1];
+    res.dual.step_size = scalars[2];
+
+    for (real_t u : res.dual.mults)
+        if (!(u >= 0.0_F) || u == limits<real_t>::inf())  // Also catches NaNs
+            throw std::invalid_argument("Invalid checkpoint: multipliers must be finite and >= 0.");
+    // An empty dual is never used (e.g., the run stopped before the first subgradient), its step
+    // size is meaningless
+    real_t const step = res.dual.step_size;
+    if (!res.dual.mults.empty() && !(step > 0.0_F && step < limits<real_t>::inf()))  // And NaNs
+        throw std::invalid_argument("Invalid checkpoint: step size must be finite and > 0.");
+    return res;
+}
+
+// Keeps only the parts of a checkpoint that are valid for inst (e.g., a perturbed version of the
+// instance it was computed on): the solution must be feasible, and its cost is recomputed with
+// the costs of inst; the multipliers must match the number of rows; out of range core columns
+// are dropped.
+inline void fit_checkpoint(Instance const& inst, CftResult& ckpt) {
+    ridx_t const nrows = rsize(inst.rows);
+    cidx_t const ncols = csize(inst.cols);
+
+    if (any(ckpt.sol.idxs, [=](cidx_t j) { return j < 0_C || j >= ncols; }))
+        ckpt.sol = Solution();
+    auto   row_coverage = CoverCounters(nrows);
+    ridx_t covered      = 0_R;
+    ckpt.sol.cost       = 0.0_F;
+    for (cidx_t j : ckpt.sol.idxs) {
+        covered += as_ridx(row_coverage.cover(inst.cols[j]));
+        ckpt.sol.cost += inst.costs[j];
+    }
+    if (covered < nrows)
+        ckpt.sol = Solution();
+
+    if (rsize(ckpt.dual.mults) != nrows)
+        ckpt.dual = DualState();
+    remove_if(ckpt.dual.core_cols, [=](cidx_t j) { return j < 0_C || j >= ncols; });
+}
+
 inline FileData parse_inst_and_initsol(Environment const& env) {
     auto fdata = FileData();
 
     if (env.parser == CFT_RAIL_PARSER) {
         print<1>(env, "CFT> Parsing RAIL instance from {}\n\n", env.inst_path);
-        fdata.inst = parse_rail_instance(env.inst_path);
+        if (env.nthreads > 1)
+            fdata.inst = parse_rail_instance(env.inst_path, ParallelParsing(env.nthreads));
+        else
+            fdata.inst = env.use_mmap ? parse_rail_instance(env.inst_path, MmapParsing{})
+                                      : parse_rail_instance(env.inst_path);
 
     } else if (env.parser == CFT_SCP_PARSER) {
         print<1>(env, "CFT> Parsing SCP instance from {}\n\n", env.inst_path);
-        fdata.inst = parse_scp_instance(env.inst_path);
+        fdata.inst = env.use_mmap ? parse_scp_instance(env.inst_path, MmapParsing{})
+                                  : parse_scp_instance(env.inst_path);
 
     } else if (env.parser == CFT_CVRP_PARSER) {
         print<1>(env, "CFT> Parsing CVRP instance from {}\n\n", env.inst_path);
-        fdata = parse_cvrp_instance(env.inst_path);
+        if (env.nthreads > 1)
+            fdata = parse_cvrp_instance(env.inst_path, ParallelParsing(env.nthreads));
+        else
+            fdata = env.use_mmap ? parse_cvrp_instance(env.inst_path, MmapParsing{})
+                                 : parse_cvrp_instance(env.inst_path);
+
+    } else if (env.parser == CFT_BINARY_PARSER) {
+        print<1>(env, "CFT> Loading binary instance from {}\n\n", env.inst_path);
+        fdata = parse_binary_instance(env.inst_path);
 
     } else if (env.parser == CFT_MPS_PARSER) {
         print<1>(env, "CFT> Parsing MPS instance from {}\n\n", env.inst_path);
-        fdata.inst = parse_mps_instance(env.inst_path);
+        fdata.inst = env.use_mmap ? parse_mps_instance(env.inst_path, MmapParsing{})
+                                  : parse_mps_instance(env.inst_path);
 
     } else {
         print<1>(env, "CFT> Parser {} does not exists.\n\n", env.parser);
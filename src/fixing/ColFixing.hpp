@@ -39,7 +39,8 @@ public:
         assert(rsize(inst.rows) == rsize(fixing.curr2orig.row_map));
         assert(rsize(inst.rows) == rsize(lagr_mult));
 
-        auto timer = Chrono<>();
+        ProfileScope prof_scope(env.profile.col_fixing);
+        auto         timer = Chrono<>();
         _select_non_overlapping_cols(inst, lagr_mult, row_coverage, cols_to_fix, reduced_costs);
         cidx_t no_overlap_ncols = csize(cols_to_fix);
 
@@ -48,6 +49,7 @@ public:
 
         fix_columns_and_compute_maps(cols_to_fix, inst, fixing, old2new);
         _apply_maps_to_lagr_mult(old2new, lagr_mult);
+        env.profile.col_fixing.work += cols_to_fix.size();
 
         print<4>(env,
                  "CFIX> Fixing {} columns ({} + {}), time {:.2f}s\n\n",
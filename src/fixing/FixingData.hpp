@@ -100,6 +100,19 @@ inline void fix_columns_and_compute_maps(std::vector<cidx_t> const& cols_to_fix,
     local::apply_maps_to_fixing_data(inst, old2new, fixing);    // After removing fixed columns
 }
 
+// Same as above, but the fixed instance is built from a read-only inst into fixed_inst, instead of
+// fixing a copy of inst inplace.
+inline void fix_columns_and_compute_maps(std::vector<cidx_t> const& cols_to_fix,  // in
+                                         Instance const&            inst,         // in
+                                         Instance&                  fixed_inst,   // out
+                                         FixingData&                fixing,       // inout
+                                         IdxsMaps&                  old2new       // out
+) {
+    local::add_cols_to_fixing_data(inst, cols_to_fix, fixing);
+    copy_without_fixed_cols(cols_to_fix, inst, fixed_inst, old2new);
+    local::apply_maps_to_fixing_data(fixed_inst, old2new, fixing);
+}
+
 }  // namespace cft
 
 #endif /* CFT_SRC_FIXING_FIXINGDATA_HPP */
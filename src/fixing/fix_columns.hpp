@@ -123,25 +123,69 @@ namespace local { namespace {
     inline void inplace_apply_row_map(IdxsMaps const& old2new,  // in
                                       Instance&       inst      // inout
     ) {
+        size_t n     = 0;
         ridx_t new_i = 0_R;
         for (ridx_t old_i = 0_R; old_i < rsize(inst.rows); ++old_i) {
             if (old2new.row_map[old_i] == removed_ridx)
                 continue;
 
-            auto& old_row = inst.rows[old_i];
-            auto& new_row = inst.rows[new_i++];
-            new_row.resize(old_row.size());
+            assert(new_i == old2new.row_map[old_i]);
+            size_t new_beg_idx = n;  // save here to set rows.begs[new_i] later
+            for (cidx_t old_j : inst.rows[old_i]) {
+                cidx_t new_j = old2new.col_map[old_j];
+                if (new_j != removed_cidx)
+                    inst.rows.idxs[n++] = new_j;
+            }
+            assert(n > new_beg_idx && "Empty row after fixing -> infeasible core instance");
+
+            inst.rows.begs[new_i] = new_beg_idx;  // here to not invalidate current row
+            ++new_i;
+        }
+        ridx_t new_nrows          = new_i;
+        inst.rows.begs[new_nrows] = n;
+        inst.rows.begs.resize(new_nrows + 1_R);
+        inst.rows.idxs.resize(n);
+    }
+
+    // Same as inplace_apply_col_map, but the remaining columns are appended to new_inst.
+    inline void copy_apply_col_map(Instance const& inst,     // in
+                                   IdxsMaps const& old2new,  // in
+                                   Instance&       new_inst  // inout
+    ) {
+        for (cidx_t old_j = 0_C; old_j < csize(inst.cols); ++old_j) {
+            if (old2new.col_map[old_j] == removed_cidx)
+                continue;
+
+            assert(csize(new_inst.cols) == old2new.col_map[old_j]);
+            for (ridx_t old_i : inst.cols[old_j]) {
+                ridx_t new_i = old2new.row_map[old_i];
+                if (new_i != removed_ridx)
+                    new_inst.cols.idxs.push_back(new_i);
+            }
+            new_inst.cols.begs.push_back(new_inst.cols.idxs.size());
+            new_inst.costs.push_back(inst.costs[old_j]);
+        }
+    }
+
+    // Same as inplace_apply_row_map, but the remaining rows are appended to new_inst.
+    inline void copy_apply_row_map(Instance const& inst,     // in
+                                   IdxsMaps const& old2new,  // in
+                                   Instance&       new_inst  // inout
+    ) {
+        for (ridx_t old_i = 0_R; old_i < rsize(inst.rows); ++old_i) {
+            if (old2new.row_map[old_i] == removed_ridx)
+                continue;
 
-            cidx_t w = 0_C;
-            for (cidx_t old_j : old_row) {
+            assert(rsize(new_inst.rows) == old2new.row_map[old_i]);
+            for (cidx_t old_j : inst.rows[old_i]) {
                 cidx_t new_j = old2new.col_map[old_j];
                 if (new_j != removed_cidx)
-                    new_row[w++] = new_j;
+                    new_inst.rows.idxs.push_back(new_j);
             }
-            new_row.resize(w);
-            assert(!new_row.empty() && "Empty row after fixing -> infeasible core instance");
+            assert(new_inst.rows.idxs.size() > new_inst.rows.begs.back() &&
+                   "Empty row after fixing -> infeasible core instance");
+            new_inst.rows.begs.push_back(new_inst.rows.idxs.size());
         }
-        inst.rows.resize(new_i);
     }
 }  // namespace
 }  // namespace local
@@ -166,6 +210,28 @@ inline void remove_fixed_cols_from_inst(std::vector<cidx_t> const& cols_to_fix,
     CFT_IF_DEBUG(local::mappings_check(old_inst, inst, old2new));  // coherent mappings
 }
 
+// Like remove_fixed_cols_from_inst, but inst is left untouched and the remaining part is written
+// to fixed_inst in a single filtered pass. Equivalent to copying inst and removing the columns
+// afterwards, without the temporary full copy; fixed_inst buffers are reused.
+inline void copy_without_fixed_cols(std::vector<cidx_t> const& cols_to_fix,  // in
+                                    Instance const&            inst,         // in
+                                    Instance&                  fixed_inst,   // out
+                                    IdxsMaps&                  old2new       // out
+) {
+    assert(&inst != &fixed_inst);
+
+    clear_inst(fixed_inst);
+    ridx_t removed_rows = local::compute_maps_from_cols_to_fix(inst, cols_to_fix, old2new);
+    if (removed_rows == rsize(inst.rows))
+        return;
+
+    local::copy_apply_col_map(inst, old2new, fixed_inst);
+    local::copy_apply_row_map(inst, old2new, fixed_inst);
+
+    CFT_IF_DEBUG(col_and_rows_check(fixed_inst.cols, fixed_inst.rows));  // coherent instance
+    CFT_IF_DEBUG(local::mappings_check(inst, fixed_inst, old2new));      // coherent mappings
+}
+
 }  // namespace cft
 
 
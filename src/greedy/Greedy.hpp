@@ -25,11 +25,13 @@ class Greedy {
     // Caches
     Scores         score_info;
     RedundancyData redund_info;
+    ProfileEntry   greedy_prof;
+    ProfileEntry   redund_prof;
 
 public:
     // The greedy algorithm:
     // 1. Initialize column scores (based on the current lagragian multipliers)
-    // 2. Add the column with the best score (until the solution is "complete")
+    // 2. Add the column with the best score (until the solution is "complete"), kept in a lazy heap
     // 3. If present, remove redundant columns from the solution
     // NOTE: a valid solution is returned only if its cost is below the cutoff_cost
     real_t operator()(Instance const&            inst,                                  // in
@@ -40,6 +42,7 @@ public:
                       cidx_t                     max_sol_size = limits<cidx_t>::max()   // in
     ) {
         ridx_t const nrows = rsize(inst.rows);
+        ProfileScope prof_scope(greedy_prof);
 
         real_t sol_cost = limits<real_t>::max();
         if (csize(sol) >= max_sol_size)
@@ -60,38 +63,37 @@ public:
 
 
         // Fill solution
-        auto   good_scores      = score_subspan_t{};
-        real_t worst_good_score = 0.0_F;
         while (nrows_to_cover > 0_R && csize(sol) < max_sol_size) {
-
-            // Get the column-fraction with best scores
-            if (good_scores.empty()) {
-                auto good_size   = min(as_cidx(nrows_to_cover), csize(inst.cols) - csize(sol));
-                good_scores      = select_good_scores(score_info, good_size);
-                worst_good_score = good_scores.back().score;
-            }
-
-            auto   min_score = range_min(good_scores, ScoreKey{});
-            cidx_t jstar     = min_score.idx;
-            assert(min_score.score < limits<real_t>::max() && "Illegal score");
+            auto   good  = min(as_cidx(nrows_to_cover), csize(inst.cols) - csize(sol));
+            auto   best  = pop_best_score(score_info, good);
+            cidx_t jstar = best.idx;
+            assert(best.score < limits<real_t>::max() && "Illegal score");
             assert(!any(sol, [=](cidx_t j) { return j == jstar; }) && "Duplicate column");
             sol.push_back(jstar);
+            ++greedy_prof.work;
 
-            update_changed_scores(inst, lagr_mult, total_cover, jstar, score_info, [&](cidx_t s) {
-                // s score changed, check if can be removed from good_scores
-                if (s < csize(good_scores) && good_scores[s].score >= worst_good_score) {
-                    cidx_t s_j    = good_scores[s].idx;
-                    cidx_t back_j = good_scores.back().idx;
-                    std::swap(good_scores[s], good_scores.back());
-                    std::swap(score_info.score_map[s_j], score_info.score_map[back_j]);
-                    good_scores = make_span(good_scores.begin(), good_scores.end() - 1U);
-                }
-            });
-
+            update_changed_scores(inst, lagr_mult, total_cover, jstar, score_info);
             nrows_to_cover -= as_ridx(total_cover.cover(inst.cols[jstar]));
         }
 
-        return _remove_redundant_cols(inst, cutoff_cost, redund_info, sol);
+        ProfileScope redund_scope(redund_prof);
+        sol_cost = _remove_redundant_cols(inst, cutoff_cost, redund_info, sol);
+        redund_prof.work += redund_info.enum_nodes;
+        return sol_cost;
+    }
+
+    // Limits of the redundant columns enumeration (see RedundancyData), e.g., from env.enum_vars
+    // and env.enum_nodes. Values above 64 variables are clamped.
+    void set_enum_limits(uint64_t max_vars, uint64_t max_nodes) {
+        redund_info.max_enum_vars  = as_cidx(min(max_vars, uint64_t{64}));
+        redund_info.max_enum_nodes = max_nodes;
+    }
+
+    // Moves the timings accumulated so far into prof (greedy and redundancy entries).
+    void flush_profile(Profile& prof) {
+        prof.greedy += greedy_prof;
+        prof.redundancy += redund_prof;
+        greedy_prof = redund_prof = ProfileEntry();
     }
 
 private:
@@ -100,6 +102,7 @@ private:
                                          RedundancyData&      redund_info,  // inout
                                          std::vector<cidx_t>& sol           // inout
     ) {
+        redund_info.enum_nodes = 0;
         complete_init_redund_set(inst, sol, cutoff_cost, redund_info);
         if (_try_early_exit(redund_info, sol))
             return redund_info.partial_cost;  // Solution will be discarded
@@ -8,13 +8,12 @@
 #include "core/Instance.hpp"
 #include "core/cft.hpp"
 #include "utils/CoverCounters.hpp"
+#include "utils/SparseBinMat.hpp"
 #include "utils/limits.hpp"
 #include "utils/sort.hpp"
 #include "utils/utility.hpp"
 
 
-#define CFT_ENUM_VARS 10_C
-
 namespace cft {
 // Data structure to store the redundancy set and related information
 struct RedundancyData {
@@ -25,6 +24,23 @@ struct RedundancyData {
     real_t                   best_cost         = limits<real_t>::max();  // current best upper bound
     real_t                   partial_cost      = 0.0_F;                  // current solution cost
     ridx_t                   partial_cov_count = 0_R;                    // number of covered rows
+
+    // Enumeration limits (see Greedy::set_enum_limits): the heuristic removal leaves at most
+    // max_enum_vars (<= 64) redundant columns, the enumeration stops (keeping its best solution)
+    // after max_enum_nodes nodes. A dive can dead-end when the cost bound prunes a column that
+    // cannot be removed either, so a search stopped by the budget may have found no solution below
+    // the cutoff: best_cost is then still the cutoff and the greedy solution gets discarded.
+    cidx_t   max_enum_vars  = 24_C;
+    uint64_t max_enum_nodes = 1ULL << 14U;
+
+    // Enumeration caches. Only the rows left uncovered by the non-redundant columns matter: they
+    // get a compact index and the bitmask of the redundant columns covering them.
+    SparseBinMat<ridx_t>  enum_cols;       // compact rows of each redundant column
+    std::vector<ridx_t>   enum_rows;       // original index of each compact row
+    std::vector<ridx_t>   row_ids;         // compact index of each row (or limits<ridx_t>::max())
+    std::vector<uint64_t> row_masks;       // redundant columns covering each compact row
+    uint64_t              best_keep  = 0;  // redundant columns kept by the best solution
+    uint64_t              enum_nodes = 0;  // nodes visited by the last enumeration
 };
 
 #ifndef NDEBUG
@@ -57,77 +73,82 @@ inline void check_redundancy_data(Instance const&            inst,
 
 namespace local { namespace {
 
-    // When the threshold is below a certain value, we can enumerate all possible
-    // non-redundant combinations. As the threshold is known at compile-time, the enumeration
-    // has a fixed maximum depth. Enumerator utilizes partial specialization (since `if
-    // constexpr` is a C++17 feature) to limit the number of enumeration steps and (technically)
-    // remove the recursion.
-    template <size_t Cur>
-    struct Enumerator;
-
-    template <>
-    struct Enumerator<CFT_ENUM_VARS> {
-        static void invoke(Instance const& /*inst*/,           // unused
-                           RedundancyData& red_data,           // inout
-                           bool const (&vars)[CFT_ENUM_VARS],  // in
-                           bool (&sol)[CFT_ENUM_VARS]          // out
-        ) {
-            if (red_data.partial_cost < red_data.best_cost) {
-                red_data.best_cost = red_data.partial_cost;
-                for (cidx_t s = 0_C; s < CFT_ENUM_VARS; ++s)
-                    sol[s] = vars[s];
-            }
-        }
-    };
-
-    template <size_t Depth>
-    struct Enumerator {
-        static void invoke(Instance const& inst,         // in
-                           RedundancyData& red_data,     // inout
-                           bool (&vars)[CFT_ENUM_VARS],  // inout
-                           bool (&sol)[CFT_ENUM_VARS]    // out
-        ) {
-            auto& partial_cover = red_data.partial_cover;
-            auto& total_cover   = red_data.total_cover;
-
-#ifndef NDEBUG
-            assert(red_data.partial_cov_count <= rsize(partial_cover));
-            for (ridx_t i = 0_R; i < rsize(partial_cover); ++i)
-                assert(partial_cover[i] <= total_cover[i]);
-#endif
+    // Depth-first branch and bound on the redundant columns (sorted by increasing cost). For each
+    // column we first try to keep it (if it covers some uncovered row and the cost bound allows),
+    // then to remove it (if every one of its rows is still covered by another available column).
+    // Coverage is tracked with bitmasks: a compact row is covered if its mask intersects `keep`,
+    // and can still be covered if it intersects `avail`.
+    inline void enumerate(RedundancyData& red_data,    // inout
+                          cidx_t          depth,       // in
+                          uint64_t        keep,        // in
+                          uint64_t        avail,       // in
+                          ridx_t          nuncovered,  // in
+                          real_t          cost         // in
+    ) {
+        if (++red_data.enum_nodes > red_data.max_enum_nodes)
+            return;
 
-            if (Depth == red_data.redund_set.size() ||
-                red_data.partial_cov_count == rsize(partial_cover)) {
-                Enumerator<CFT_ENUM_VARS>::invoke(inst, red_data, vars, sol);
-                return;
+        if (nuncovered == 0_R || depth == csize(red_data.redund_set)) {
+            assert(nuncovered == 0_R && "Uncovered rows left");
+            if (cost < red_data.best_cost) {
+                red_data.best_cost = cost;
+                red_data.best_keep = keep;
             }
+            return;
+        }
 
-            cidx_t col_idx = red_data.redund_set[Depth].idx;
-            auto   col     = inst.cols[col_idx];
-
-            assert(!partial_cover.is_redundant_cover(col) || total_cover.is_redundant_uncover(col));
-
-            if (red_data.partial_cost + red_data.redund_set[Depth].cost < red_data.best_cost &&
-                !partial_cover.is_redundant_cover(col)) {
-
-                vars[Depth] = true;
-                red_data.partial_cov_count += as_ridx(partial_cover.cover(col));
-                red_data.partial_cost += red_data.redund_set[Depth].cost;
-
-                Enumerator<Depth + 1>::invoke(inst, red_data, vars, sol);
+        auto     col      = red_data.enum_cols[depth];
+        uint64_t col_bit  = uint64_t{1} << native_cast(depth);
+        real_t   col_cost = red_data.redund_set[depth].cost;
+
+        if (cost + col_cost < red_data.best_cost) {
+            ridx_t newly_covered = 0_R;
+            for (ridx_t r : col)
+                newly_covered += (red_data.row_masks[r] & keep) == 0 ? 1_R : 0_R;
+            if (newly_covered > 0_R)
+                enumerate(red_data,
+                          depth + 1_C,
+                          keep | col_bit,
+                          avail,
+                          nuncovered - newly_covered,
+                          cost + col_cost);
+        }
 
-                vars[Depth] = false;
-                red_data.partial_cov_count -= as_ridx(partial_cover.uncover(col));
-                red_data.partial_cost -= red_data.redund_set[Depth].cost;
-            }
+        uint64_t new_avail = avail & ~col_bit;
+        if (all(col, [&](ridx_t r) { return (red_data.row_masks[r] & new_avail) != 0; }))
+            enumerate(red_data, depth + 1_C, keep, new_avail, nuncovered, cost);
+    }
 
-            if (total_cover.is_redundant_uncover(col)) {
-                total_cover.uncover(col);
-                Enumerator<Depth + 1>::invoke(inst, red_data, vars, sol);
-                total_cover.cover(col);
+    // Builds the compact rows and their masks for the current redundant set.
+    inline ridx_t init_enumeration(Instance const& inst,     // in
+                                   RedundancyData& red_data  // inout
+    ) {
+        ridx_t const no_id = limits<ridx_t>::max();
+        red_data.row_ids.resize(rsize(inst.rows), no_id);
+        red_data.enum_cols.clear();
+        red_data.enum_rows.clear();
+        red_data.row_masks.clear();
+
+        for (cidx_t r = 0_C; r < csize(red_data.redund_set); ++r) {
+            uint64_t col_bit = uint64_t{1} << native_cast(r);
+            for (ridx_t i : inst.cols[red_data.redund_set[r].idx]) {
+                if (red_data.partial_cover[i] > 0)
+                    continue;  // Covered anyway
+                if (red_data.row_ids[i] == no_id) {
+                    red_data.row_ids[i] = rsize(red_data.enum_rows);
+                    red_data.enum_rows.push_back(i);
+                    red_data.row_masks.push_back(0);
+                }
+                red_data.row_masks[red_data.row_ids[i]] |= col_bit;
+                red_data.enum_cols.idxs.push_back(red_data.row_ids[i]);
             }
+            red_data.enum_cols.begs.push_back(red_data.enum_cols.idxs.size());
         }
-    };
+
+        for (ridx_t i : red_data.enum_rows)
+            red_data.row_ids[i] = no_id;  // Reset only what was touched
+        return rsize(red_data.enum_rows);
+    }
 
 }  // namespace
 }  // namespace local
@@ -157,32 +178,33 @@ inline void complete_init_redund_set(Instance const&            inst,         //
 }
 
 // Remove redundant columns from the redundancy set using an implicit enumeration. NOTE: assumes
-// no more than CFT_ENUM_VARS columns are redundant.
+// no more than max_enum_vars columns are redundant.
 inline void enumeration_removal(Instance const& inst,    // in
                                 RedundancyData& red_set  // inout
 ) {
-    assert(csize(red_set.redund_set) <= CFT_ENUM_VARS);
-    real_t old_ub = red_set.best_cost;
+    assert(csize(red_set.redund_set) <= min(red_set.max_enum_vars, 64_C));
+    real_t old_ub      = red_set.best_cost;
+    red_set.enum_nodes = 0;
     if (red_set.partial_cost >= old_ub || red_set.redund_set.empty())
         return;
 
-    bool curr_keep_state[CFT_ENUM_VARS] = {};
-    bool cols_to_keep[CFT_ENUM_VARS]    = {};
-
-    local::Enumerator<0>::invoke(inst, red_set, curr_keep_state, cols_to_keep);
+    ridx_t nuncovered = local::init_enumeration(inst, red_set);
+    red_set.best_keep = 0;
+    local::enumerate(red_set, 0_C, 0, ~uint64_t{0}, nuncovered, red_set.partial_cost);
 
     if (red_set.best_cost < old_ub)
         for (cidx_t r = 0_C; r < csize(red_set.redund_set); ++r)
-            if (!cols_to_keep[r])
+            if ((red_set.best_keep & (uint64_t{1} << native_cast(r))) == 0)
                 red_set.cols_to_remove.push_back(red_set.redund_set[r].idx);
 }
 
 // Remove redundant columns from the redundancy set using an heuristic greedy approach until
-// CFT_ENUM_VARS columns are left.
+// max_enum_vars columns are left.
 inline void heuristic_removal(Instance const& inst,    // in
                               RedundancyData& red_set  // inout
 ) {
-    while (red_set.partial_cost < red_set.best_cost && csize(red_set.redund_set) > CFT_ENUM_VARS) {
+    cidx_t const max_vars = min(red_set.max_enum_vars, 64_C);  // One bit per column
+    while (red_set.partial_cost < red_set.best_cost && csize(red_set.redund_set) > max_vars) {
 
         if (red_set.partial_cov_count == rsize(inst.rows))
             return;
@@ -12,6 +12,7 @@
 #include "core/cft.hpp"
 #include "utils/CoverCounters.hpp"
 #include "utils/limits.hpp"
+#include "utils/Span.hpp"
 #include "utils/sort.hpp"
 #include "utils/utility.hpp"
 
@@ -27,16 +28,22 @@ struct ScoreKey {
     }
 };
 
-using score_subspan_t = Span<container_iterator_t<std::vector<ScoreData>>>;
-
+// Column scores can only increase while the greedy solution grows: gammas increase by the
+// (non-negative) multipliers of the newly covered rows, while mu decreases. This allows to keep
+// scores lazily: updates only touch gammas and covered_rows, while scores are recomputed when
+// looked at. The best ("good") scores are kept in a 4-ary min-heap at the front of `scores`, an
+// outdated heap top is pushed down again with its current score, or dropped if it is no longer
+// better than the worst good score. The other scores are not looked at until the heap empties.
 struct Scores {
-    std::vector<ScoreData> scores;        // column scores
+    std::vector<ScoreData> scores;        // column scores (possibly outdated)
     std::vector<real_t>    gammas;        // gamma values used to compute scores
     std::vector<ridx_t>    covered_rows;  // number of rows that can be covered by each column
-    std::vector<cidx_t>    score_map;     // maps column index to score index
+    cidx_t                 good_size  = 0_C;                     // heap size (front of scores)
+    real_t                 worst_good = limits<real_t>::max();  // good scores threshold
 };
 
 namespace local { namespace {
+    constexpr size_t heap_arity = 4;  // Shallower than binary, siblings share cache lines
 
     // Score computed as described in the paper. Mu represents the number of rows that would be
     // covered by the current column. Gamma represents the reduced cost of the column minus the
@@ -49,28 +56,56 @@ namespace local { namespace {
         return gamma * as_real(mu);
     }
 
-    template <typename Hook>
-    void update_row_scores(std::vector<cidx_t> const& row,          // in
-                           real_t                     i_lagr_mult,  // in
-                           Scores&                    score_info,   // inout
-                           Hook                       update_hook   // in
-    ) {
-        auto& scores = score_info.scores;  // shorthand
+    // Moves heap[pos] down until the heap property is restored.
+    inline void heap_sift_down(ScoreData* heap, size_t hsize, size_t pos) {
+        ScoreData const elem = heap[pos];
+        for (;;) {
+            size_t first = pos * heap_arity + 1;
+            if (first >= hsize)
+                break;
+            size_t last = min(first + heap_arity, hsize);
+            size_t best = first;
+            for (size_t c = first + 1; c < last; ++c)
+                if (heap[c].score < heap[best].score)
+                    best = c;
+            if (!(heap[best].score < elem.score))
+                break;
+            heap[pos] = heap[best];
+            pos       = best;
+        }
+        heap[pos] = elem;
+    }
 
+    inline void heap_make(ScoreData* heap, size_t hsize) {
+        if (hsize < 2)
+            return;
+        for (size_t pos = (hsize - 2) / heap_arity + 1; pos-- > 0;)
+            heap_sift_down(heap, hsize, pos);
+    }
+
+    // The top is moved right after the end of the heap.
+    inline void heap_pop(ScoreData* heap, size_t hsize) {
+        assert(hsize > 0);
+        std::swap(heap[0], heap[hsize - 1]);
+        heap_sift_down(heap, hsize - 1, 0);
+    }
+
+    inline void update_row_scores(Span<cidx_t const*> row,          // in
+                                  real_t              i_lagr_mult,  // in
+                                  Scores&             score_info    // inout
+    ) {
+        assert(i_lagr_mult >= 0.0_F && "Negative multipliers would break scores monotonicity");
         for (cidx_t j : row) {
             score_info.covered_rows[j] -= 1_R;
             score_info.gammas[j] += i_lagr_mult;
-
-            cidx_t s = score_info.score_map[j];
-            assert(s != removed_cidx && "Column is not in the score map");
-            scores[s].score = local::compute_score(score_info.gammas[j],
-                                                   score_info.covered_rows[j]);
             assert(std::isfinite(score_info.gammas[j]) && "Gamma is not finite");
-            assert(std::isfinite(scores[s].score) && "Score is not finite");
-            update_hook(s);  // further ops on s element
         }
     }
 
+    inline real_t current_score(Scores const& score_info, cidx_t j) {
+        return compute_score(score_info.gammas[j], score_info.covered_rows[j]);
+    }
+
 }  // namespace
 }  // namespace local
 
@@ -82,13 +117,13 @@ inline void complete_scores_init(Instance const& inst,       // in
 
     cidx_t ncols = csize(inst.cols);
     score_info.scores.clear();
-    score_info.score_map.resize(ncols);
     score_info.covered_rows.resize(ncols);
+    score_info.good_size  = 0_C;
+    score_info.worst_good = limits<real_t>::max();
 
     for (cidx_t j = 0_C; j < csize(inst.cols); ++j) {
         ridx_t cover_num           = rsize(inst.cols[j]);
         real_t score               = local::compute_score(score_info.gammas[j], cover_num);
-        score_info.score_map[j]    = j;
         score_info.covered_rows[j] = cover_num;
         score_info.scores.push_back({score, j});
         assert(std::isfinite(score_info.gammas[j]) && "Gamma is not finite");
@@ -108,37 +143,70 @@ inline ridx_t update_covered(Instance const&            inst,         // in
 
     for (ridx_t i = 0_R; i < rsize(row_coverage); i++)
         if (row_coverage[i] > 0)
-            local::update_row_scores(inst.rows[i], lagr_mult[i], score_info, NoOp{});
+            local::update_row_scores(inst.rows[i], lagr_mult[i], score_info);
 
     return covered_rows;
 }
 
-template <typename Hook>
 inline void update_changed_scores(Instance const&            inst,          // in
                                   std::vector<real_t> const& lagr_mult,     // in
                                   CoverCounters const&       row_coverage,  // in
                                   cidx_t                     jstar,         // in
-                                  Scores&                    score_info,    // inout
-                                  Hook                       update_hook    // in
+                                  Scores&                    score_info     // inout
 ) {
     auto col_star = inst.cols[jstar];
     for (ridx_t i : col_star)
         if (row_coverage[i] == 0)
-            local::update_row_scores(inst.rows[i], lagr_mult[i], score_info, update_hook);
+            local::update_row_scores(inst.rows[i], lagr_mult[i], score_info);
 }
 
-inline score_subspan_t select_good_scores(Scores& score_info,  // in
-                                          cidx_t  how_many     // in
+// Refreshes all the scores and moves the how_many best ones in the heap.
+inline void select_good_scores(Scores& score_info,  // inout
+                               cidx_t  how_many     // in
 ) {
     assert(how_many > 0_C && "Good size must be greater than 0");
     auto& scores = score_info.scores;  // shorthand
 
+    for (ScoreData& sd : scores)
+        sd.score = local::current_score(score_info, sd.idx);
+
     how_many = std::min(how_many, csize(scores));
     cft::nth_element(scores, how_many - 1_C, ScoreKey{});
-    for (cidx_t s = 0_C; s < csize(scores); ++s)
-        score_info.score_map[scores[s].idx] = s;
+    score_info.good_size  = how_many;
+    score_info.worst_good = scores[how_many - 1_C].score;
+    local::heap_make(scores.data(), checked_cast<size_t>(how_many));
+}
 
-    return make_span(scores.begin(), how_many);
+// Removes and returns the column with the minimum current score, refilling the good scores heap
+// with the how_many best scores when it runs empty.
+inline ScoreData pop_best_score(Scores& score_info,  // inout
+                                cidx_t  how_many     // in
+) {
+    ScoreData* heap = score_info.scores.data();
+    for (;;) {
+        if (score_info.good_size == 0_C) {
+            select_good_scores(score_info, how_many);
+            heap = score_info.scores.data();
+        }
+        auto      hsize = checked_cast<size_t>(score_info.good_size);
+        ScoreData top   = heap[0];
+        real_t    cur   = local::current_score(score_info, top.idx);
+        assert(std::isfinite(cur) && "Score is not finite");
+        assert(cur >= top.score && "Scores can only increase");
+
+        if (cur <= top.score || cur < score_info.worst_good) {
+            if (cur <= top.score) {  // Up to date: the best overall
+                local::heap_pop(heap, hsize);
+                score_info.good_size -= 1_C;
+                return top;
+            }
+            heap[0].score = cur;  // Outdated, but still good: push it down
+            local::heap_sift_down(heap, hsize, 0);
+        } else {
+            local::heap_pop(heap, hsize);  // No longer good, leave it to the next refill
+            score_info.good_size -= 1_C;
+        }
+    }
 }
 }  // namespace cft
 
@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Second instantiation of the whole solver with 32-bit row indexes, used by main() when an instance
+// has too many rows for the default 16-bit ones. The library is header-only and configured through
+// macros, so the namespace is renamed to keep the two instantiations apart.
+#ifdef CFT_RIDX_TYPE
+#error "main_wide_rows.cpp sets its own row index type"
+#endif
+#define CFT_RIDX_TYPE int32_t
+
+// The rename is a plain token substitution over everything included below: the headers must not
+// use `cft` as an identifier other than the namespace name (no variable, member, macro argument or
+// string-pasted token called `cft`), and must not include third-party headers that do.
+#define cft cft_wide_rows
+
+#include <chrono>
+
+#include "core/cli_main.hpp"
+
+int cft_wide_rows_main(int argc, char const** argv, std::chrono::steady_clock::time_point start) {
+    return cft::cli_main(argc, argv, start, true);
+}
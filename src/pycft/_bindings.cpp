@@ -2,9 +2,10 @@
 // SPDX-License-Identifier: MIT
 
 // pybind11
-#include <pybind11/operators.h>  // To define operator overloading
-#include <pybind11/pybind11.h>   // Basic pybind11 functionality
-#include <pybind11/stl.h>        // Automatic conversion of vectors
+#include <pybind11/functional.h>  // Automatic conversion of callables
+#include <pybind11/operators.h>   // To define operator overloading
+#include <pybind11/pybind11.h>    // Basic pybind11 functionality
+#include <pybind11/stl.h>         // Automatic conversion of vectors
 
 #include <stdexcept>
 
@@ -50,6 +51,26 @@ namespace local { namespace {
         // Fill rows from columns
         fill_rows_from_cols(cols, n, rows);
     }
+
+    // Column-major (ridx_t) and row-major (cidx_t) matrices share the same interface
+    template <typename IdxT>
+    void bind_sparse_bin_mat(pybind11::module_& m, char const* name) {
+        namespace py = pybind11;
+        using MatT   = cft::SparseBinMat<IdxT>;
+        py::class_<MatT>(m, name)
+            .def(py::init<>())
+            .def_readwrite("idxs", &MatT::idxs)
+            .def_readwrite("begs", &MatT::begs)
+            .def("__getitem__", [](MatT& self, std::size_t i) { return self[i]; })
+            .def("__len__", &MatT::size)
+            .def("__repr__",
+                 [name](MatT const& a) {
+                     return fmt::format("{}(idxs={}, begs={})", name, a.idxs, a.begs);
+                 })
+            .def("clear", &MatT::clear)
+            .def("push_back",
+                 static_cast<void (MatT::*)(std::vector<IdxT> const&)>(&MatT::push_back));
+    }
 }  // namespace
 }  // namespace local
 
@@ -76,7 +97,16 @@ PYBIND11_MODULE(_bindings, m) {
         .def_readwrite("abs_subgrad_exit", &Environment::abs_subgrad_exit)
         .def_readwrite("rel_subgrad_exit", &Environment::rel_subgrad_exit)
         .def_readwrite("use_unit_costs", &Environment::use_unit_costs)
+        .def_readwrite("use_mmap", &Environment::use_mmap)
+        .def_readwrite("nthreads", &Environment::nthreads)
+        .def_readwrite("portfolio", &Environment::portfolio)
+        .def_readwrite("red_costs_period", &Environment::red_costs_period)
+        .def_readwrite("enum_vars", &Environment::enum_vars)
+        .def_readwrite("enum_nodes", &Environment::enum_nodes)
         .def_readwrite("min_fixing", &Environment::min_fixing)
+        // Called from a solver thread with (solution, lower bound, elapsed seconds)
+        .def_readwrite("on_incumbent", &Environment::on_incumbent)
+        .def_readwrite("stop_token", &Environment::stop_token)
         .def("__repr__", [](Environment const& a) {
             return fmt::format("Environment(inst_path='{}', sol_path='{}', initsol_path='{}', "
                                "parser={}, "
@@ -98,20 +128,16 @@ PYBIND11_MODULE(_bindings, m) {
                                a.rel_subgrad_exit,
                                a.use_unit_costs);
         });
-    py::class_<SparseBinMat<ridx_t>>(m, "SparseBinMat")
+    // Shared with the solver, so that another Python thread can stop a running solve
+    py::class_<StopToken, std::shared_ptr<StopToken>>(m, "StopToken")
         .def(py::init<>())
-        .def_readwrite("idxs", &SparseBinMat<ridx_t>::idxs)
-        .def_readwrite("begs", &SparseBinMat<ridx_t>::begs)
-        .def("__getitem__", [](SparseBinMat<ridx_t>& self, std::size_t i) { return self[i]; })
-        .def("__len__", &SparseBinMat<ridx_t>::size)
-        .def("__repr__",
-             [](SparseBinMat<ridx_t> const& a) {
-                 return fmt::format("SparseBinMat(idxs={}, begs={})", a.idxs, a.begs);
-             })
-        .def("clear", &SparseBinMat<ridx_t>::clear)
-        .def("push_back",
-             static_cast<void (SparseBinMat<ridx_t>::*)(std::vector<ridx_t> const&)>(
-                 &SparseBinMat<ridx_t>::push_back));
+        .def("request_stop", &StopToken::request_stop)
+        .def("set_timeout", &StopToken::set_timeout, py::arg("seconds"))
+        .def("reset", &StopToken::reset)
+        .def("stop_requested", &StopToken::stop_requested);
+
+    ::local::bind_sparse_bin_mat<ridx_t>(m, "SparseBinMat");
+    ::local::bind_sparse_bin_mat<cidx_t>(m, "SparseBinMatRows");
 
 
     py::class_<Instance>(m, "Instance")
@@ -135,6 +161,7 @@ PYBIND11_MODULE(_bindings, m) {
         .def(py::init<>())
         .def_readwrite("sol", &CftResult::sol)
         .def_readwrite("dual", &CftResult::dual)
+        .def_readwrite("sol_time", &CftResult::sol_time)
         .def("copy", [](CftResult const& a) { return a; })
         .def("__repr__", [](CftResult const& a) {
             return fmt::format("CftResult(sol=({},{}), dual=({},{}))",
@@ -157,6 +184,8 @@ PYBIND11_MODULE(_bindings, m) {
         .def(py::init<>())
         .def_readwrite("idxs", &DualState::mults)
         .def_readwrite("cost", &DualState::lb)
+        .def_readwrite("core_cols", &DualState::core_cols)
+        .def_readwrite("step_size", &DualState::step_size)
         .def("copy", [](DualState const& a) { return a; })
         .def("__repr__", [](DualState const& a) {
             return fmt::format("DualState(mults={}, lb={})", a.mults, a.lb);
@@ -174,5 +203,12 @@ PYBIND11_MODULE(_bindings, m) {
     m.def("fill_rows_from_cols", &fill_rows_from_cols, "Fill rows from columns.");
 
 
-    m.def("run", &run, "Run the accft solver.");
+    m.def("run",
+          &run,
+          "Run the accft solver.",
+          py::call_guard<py::gil_scoped_release>(),  // The on_incumbent thread needs the GIL
+          py::arg("env"),
+          py::arg("inst"),
+          py::arg("warmstart_sol")  = Solution(),
+          py::arg("warmstart_dual") = DualState());
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 # SPDX-License-Identifier: MIT
 
 from pathlib import Path
+from typing import Callable
 from ._bindings import (
     Environment,
     parse_inst_and_initsol,
@@ -9,6 +10,7 @@ from ._bindings import (
     Instance,
     Solution,
     CftResult,
+    StopToken,
 )
 
 
@@ -51,6 +53,7 @@ class SetCoverSolver:
         self._instance = Instance()
         self._initialized = False
         self._max_element = -1
+        self._stop_token = StopToken()
 
     def add_set(self, elements: list[int], cost: float) -> int:
         """
@@ -99,6 +102,9 @@ class SetCoverSolver:
         abs_subgrad_exit: float = 1.0,
         rel_subgrad_exit: float = 0.001,
         min_fixing=0.3,
+        enum_vars: int = 24,
+        enum_nodes: int = 16384,
+        on_incumbent: Callable[[list[int], float, float, float], None] | None = None,
     ) -> None:
         """
         Solves the set cover problem using the specified parameters.
@@ -114,6 +120,10 @@ class SetCoverSolver:
         abs_subgrad_exit (float): Minimum LBs delta to trigger subgradient termination. Default is 1.0.
         rel_subgrad_exit (float): Minimum LBs gap to trigger subgradient termination. Default is 0.001.
         use_unit_costs (bool): Solve the given instance setting columns cost to one. Default is False.
+        enum_vars (int): Redundant columns of a greedy solution left to enumerate, at most 64. Default is 24.
+        enum_nodes (int): Node budget of the redundant columns enumeration. Default is 16384.
+        on_incumbent (callable): Called with (solution, cost, lower_bound, elapsed_seconds) each time
+            an improving solution is found, from a separate thread. Default is None.
 
         Returns:
         None
@@ -129,6 +139,14 @@ class SetCoverSolver:
         env.abs_subgrad_exit = abs_subgrad_exit
         env.rel_subgrad_exit = rel_subgrad_exit
         env.min_fixing = min_fixing
+        env.enum_vars = enum_vars
+        env.enum_nodes = enum_nodes
+        self._stop_token.reset()
+        env.stop_token = self._stop_token
+        if on_incumbent is not None:
+            env.on_incumbent = lambda sol, lb, time: on_incumbent(
+                list(sol.idxs), sol.cost, lb, time
+            )
         if not self._initialized:
             self._instance.rows.clear()
             self._instance.prepare()
@@ -136,6 +154,13 @@ class SetCoverSolver:
         init_sol = Solution() if self._result is None else self._result.sol
         self._result = run(env, self._instance, init_sol).copy()
 
+    def stop(self) -> None:
+        """
+        Stop the running solve as soon as possible, e.g., from another thread. The solve returns
+        within milliseconds, keeping the best solution found so far.
+        """
+        self._stop_token.request_stop()
+
     def get_solution(self) -> list[int] | None:
         """
         Return the indices of the selected sets in the solution.
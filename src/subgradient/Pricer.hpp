@@ -5,25 +5,114 @@
 #define CFT_SRC_SUBGRADIENT_PRICER_HPP
 
 
+#include <algorithm>
 #include <vector>
 
 #include "core/Instance.hpp"
 #include "core/cft.hpp"
 #include "core/utils.hpp"
 #include "utils/SortedArray.hpp"
+#include "utils/SparseBinMat.hpp"
+#include "utils/parallel.hpp"
 #include "utils/sort.hpp"
 
+// Vectorized threshold filter for the C2 selection, same conditions as the reduced-cost kernel in
+// core/utils.hpp.
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+#include <immintrin.h>
+#endif
+
 namespace cft {
+namespace local { namespace {
+    // Inserts row[k:] into a full heap keeping the cheapest columns. Most columns are rejected, so
+    // their reduced cost is only compared with the current threshold.
+    template <typename Heap, typename IdxT, typename RealT>
+    void insert_cheapest_tail(Span<IdxT const*> row,            // in
+                              size_t            k,              // in
+                              RealT const*      reduced_costs,  // in
+                              Heap&             heap            // inout
+    ) {
+        RealT thresh = reduced_costs[heap.back()];
+        for (; k < row.size(); ++k)
+            if (reduced_costs[row[k]] < thresh) {
+                heap.try_insert(row[k]);
+                thresh = reduced_costs[heap.back()];
+            }
+    }
+
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+    // Gathers the reduced costs of 16 columns at a time: a chunk without cheaper columns costs a
+    // gather and a compare. Cheaper columns are inserted in order and the rest of the chunk is
+    // compared again with the new threshold, so the result is the same as the scalar loop.
+    template <typename Heap>
+    void insert_cheapest_tail(Span<int32_t const*> row,            // in
+                              size_t               k,              // in
+                              float const*         reduced_costs,  // in
+                              Heap&                heap            // inout
+    ) {
+        int32_t const* idxs   = row.begin();
+        size_t const   sz     = row.size();
+        __m512         thresh = _mm512_set1_ps(reduced_costs[heap.back()]);
+        for (; k < sz; k += 16) {
+            size_t    rem  = sz - k;
+            __mmask16 load = rem >= 16 ? __mmask16(0xFFFF) : __mmask16((1U << rem) - 1U);
+            __m512i   vidx = _mm512_maskz_loadu_epi32(load, idxs + k);
+            __m512    vrc  = _mm512_mask_i32gather_ps(
+                _mm512_setzero_ps(), load, vidx, reduced_costs, 4);
+            __mmask16 mask = _mm512_mask_cmp_ps_mask(load, vrc, thresh, _CMP_LT_OQ);
+            while (mask != 0) {
+                unsigned lane = __builtin_ctz(mask);
+                heap.try_insert(idxs[k + lane]);
+                thresh = _mm512_set1_ps(reduced_costs[heap.back()]);
+                mask   = _mm512_mask_cmp_ps_mask(mask & (mask - 1U), vrc, thresh, _CMP_LT_OQ);
+            }
+        }
+    }
+#endif
+
+    template <typename Heap>
+    void insert_cheapest(Span<cidx_t const*> row,            // in
+                         real_t const*       reduced_costs,  // in
+                         Heap&               heap            // inout
+    ) {
+        size_t k = 0;
+        for (; k < row.size() && heap.size() < heap.capacity(); ++k)
+            heap.insert(row[k]);
+        if (k < row.size())
+            insert_cheapest_tail(row, k, reduced_costs, heap);
+    }
+}  // namespace
+}  // namespace local
 
 class Pricer {
     static constexpr int mincov = 5;
 
+    // Lower bound partial sums are computed per block of columns and then added in block order, so
+    // the result does not depend on the number of threads.
+    static constexpr size_t lb_block_size = 4096;
+
+    // Below this amount of nonzeros per thread, spawning threads is not worth it.
+    static constexpr size_t min_nnz_per_thread = 1ULL << 16U;
+
     // Caches.
-    std::vector<real_t> reduced_costs;
-    std::vector<bool>   taken_idxs;
+    std::vector<real_t>              reduced_costs;
+    std::vector<bool>                taken_idxs;
+    std::vector<cidx_t>              new_col_map;
+    std::vector<real_t>              block_lbs;    // Lower bound contribution of each block
+    std::vector<size_t>              col_splits;   // Column range of each thread
+    std::vector<size_t>              row_splits;   // Row range of each thread
+    std::vector<std::vector<cidx_t>> thread_idxs;  // Columns selected by each thread
+
+    // Snapshot of the last (instance, core) pair built by this pricer. If the next call receives
+    // the same instance and the same core, the core is updated instead of being rebuilt.
+    Instance const*     prev_inst  = nullptr;
+    cidx_t              prev_ncols = 0_C;
+    size_t              prev_nnz   = 0;
+    std::vector<cidx_t> prev_col_map;
 
 public:
-    real_t operator()(Instance const&            inst,       // in
+    real_t operator()(Environment const&         env,        // in
+                      Instance const&            inst,       // in
                       std::vector<real_t> const& lagr_mult,  // in
                       InstAndMap&                core        // out
     ) {
@@ -34,46 +123,104 @@ public:
         if (nrows == 0_R || ncols == 0_C)
             return 0.0_F;
 
-        core.col_map.clear();
+        ProfileScope prof_scope(env.profile.pricing);
+        env.profile.pricing.work += inst.cols.idxs.size() + inst.rows.idxs.size();
+
+        size_t const nthreads = clamp(inst.cols.idxs.size() / min_nnz_per_thread,
+                                      size_t{1},
+                                      checked_cast<size_t>(env.nthreads));
+        _split_by_nnz(inst.cols, nthreads, lb_block_size, col_splits);
+        _split_by_nnz(inst.rows, nthreads, 1, row_splits);
+        thread_idxs.resize(nthreads);
+
+        new_col_map.clear();
         taken_idxs.assign(ncols, false);
 
-        auto real_lower_bound = _compute_col_reduced_costs(inst, lagr_mult, reduced_costs);
-        _select_c1_col_idxs(inst, reduced_costs, core.col_map, taken_idxs);
-        _select_c2_col_idxs(inst, reduced_costs, core.col_map, taken_idxs);
+        auto real_lower_bound = _compute_col_reduced_costs(inst, lagr_mult);
+        _select_c1_col_idxs(inst, new_col_map);
+        _select_c2_col_idxs(inst, new_col_map);
 
-        _init_partial_instance(inst, core.col_map, core.inst);
+        if (_is_prev_core(inst, core))
+            _update_partial_instance(inst, new_col_map, taken_idxs, core);
+        else
+            _init_partial_instance(inst, new_col_map, core);
         fill_rows_from_cols(core.inst.cols, nrows, core.inst.rows);
 
+        prev_inst    = &inst;
+        prev_ncols   = ncols;
+        prev_nnz     = inst.cols.idxs.size();
+        prev_col_map = core.col_map;
+
         return real_lower_bound;
     }
 
 private:
-    static real_t _compute_col_reduced_costs(Instance const&            inst,          // in
-                                             std::vector<real_t> const& lagr_mult,     // in
-                                             std::vector<real_t>&       reduced_costs  // out
+    // Splits the elements (columns or rows) of mat in nparts ranges with roughly the same number of
+    // nonzeros. Range boundaries are multiples of align, except for the last one.
+    template <typename IdxT>
+    static void _split_by_nnz(SparseBinMat<IdxT> const& mat,     // in
+                              size_t                    nparts,  // in
+                              size_t                    align,   // in
+                              std::vector<size_t>&      splits   // out
     ) {
-        real_t real_lower_bound = 0.0_F;
-        for (real_t u : lagr_mult)
-            real_lower_bound += u;
+        size_t const nelems = mat.size();
+        size_t const nnz    = mat.idxs.size();
+
+        splits.assign(nparts + 1, nelems);
+        splits[0] = 0;
+        for (size_t t = 1; t < nparts; ++t) {
+            size_t target = nnz * t / nparts;
+            auto   beg_it = std::lower_bound(mat.begs.begin(), mat.begs.end() - 1, target);
+            size_t elem   = checked_cast<size_t>(beg_it - mat.begs.begin());  // first elem after
+            splits[t]     = max(elem / align * align, splits[t - 1]);
+        }
+    }
 
-        compute_reduced_costs(inst, lagr_mult, reduced_costs, [&](real_t red_cost, cidx_t /*j*/) {
-            if (red_cost < 0.0_F)
-                real_lower_bound += red_cost;
+    real_t _compute_col_reduced_costs(Instance const&            inst,      // in
+                                      std::vector<real_t> const& lagr_mult  // in
+    ) {
+        cidx_t const ncols = csize(inst.cols);
+        reduced_costs.resize(ncols);
+        block_lbs.assign((inst.cols.size() + lb_block_size - 1) / lb_block_size, 0.0_F);
+
+        parallel_run(col_splits.size() - 1, [&](size_t t) {
+            for (size_t b = col_splits[t] / lb_block_size; b * lb_block_size < col_splits[t + 1];
+                 ++b) {
+                auto   beg      = as_cidx(b * lb_block_size);
+                auto   end      = as_cidx(min((b + 1) * lb_block_size, col_splits[t + 1]));
+                real_t block_lb = 0.0_F;
+                compute_range_reduced_costs(
+                    inst, lagr_mult, beg, end, reduced_costs, [&](real_t red_cost, cidx_t /*j*/) {
+                        block_lb += min(red_cost, 0.0_F);
+                    });
+                block_lbs[b] = block_lb;
+            }
         });
 
+        real_t real_lower_bound = 0.0_F;
+        for (real_t u : lagr_mult)
+            real_lower_bound += u;
+        for (real_t block_lb : block_lbs)
+            real_lower_bound += block_lb;
         return real_lower_bound;
     }
 
-    static void _select_c1_col_idxs(Instance const&            inst,           // in
-                                    std::vector<real_t> const& reduced_costs,  // in
-                                    std::vector<cidx_t>&       idxs,           // inout
-                                    std::vector<bool>&         taken_idxs      // inout
+    // Each thread collects the candidates of its columns range, ranges are then concatenated in
+    // order. The result is the same as a sequential scan.
+    void _select_c1_col_idxs(Instance const&      inst,  // in
+                             std::vector<cidx_t>& idxs   // inout
     ) {
         assert(idxs.empty());
 
-        for (cidx_t j = 0_C; j < csize(inst.cols); ++j)
-            if (reduced_costs[j] < 0.1_F)
-                idxs.push_back(j);
+        parallel_run(thread_idxs.size(), [&](size_t t) {
+            auto& local_idxs = thread_idxs[t];
+            local_idxs.clear();
+            for (size_t j = col_splits[t]; j < col_splits[t + 1]; ++j)
+                if (reduced_costs[j] < 0.1_F)
+                    local_idxs.push_back(as_cidx(j));
+        });
+        for (auto const& local_idxs : thread_idxs)
+            idxs.insert(idxs.end(), local_idxs.begin(), local_idxs.end());
 
         cidx_t const maxsize = as_cidx(5_R * rsize(inst.rows));
         if (csize(idxs) > maxsize) {
@@ -85,39 +232,93 @@ private:
             taken_idxs[j] = true;
     }
 
-    static void _select_c2_col_idxs(Instance const&            inst,           // in
-                                    std::vector<real_t> const& reduced_costs,  // in
-                                    std::vector<cidx_t>&       idxs,           // inout
-                                    std::vector<bool>&         taken_idxs      // inout
+    // Each thread computes the best columns of its rows range, skipping the ones already taken by
+    // C1 (read-only during the parallel part). Duplicates among rows are then removed in row order,
+    // giving the same result as a sequential scan.
+    void _select_c2_col_idxs(Instance const&      inst,  // in
+                             std::vector<cidx_t>& idxs   // inout
     ) {
-        ridx_t const nrows = rsize(inst.rows);
+        parallel_run(thread_idxs.size(), [&](size_t t) {
+            auto& local_idxs = thread_idxs[t];
+            local_idxs.clear();
 
-        auto heap = make_custom_key_sorted_array<cidx_t, mincov>(
-            [&](cidx_t j) { return reduced_costs[j]; });
+            auto heap = make_custom_key_sorted_array<cidx_t, mincov>(
+                [&](cidx_t j) { return reduced_costs[j]; });
+            for (size_t i = row_splits[t]; i < row_splits[t + 1]; ++i) {
+                heap.clear();
+                local::insert_cheapest(inst.rows[i], reduced_costs.data(), heap);
+                for (cidx_t j : heap)
+                    if (!taken_idxs[j])
+                        local_idxs.push_back(j);
+            }
+        });
 
-        for (ridx_t i = 0_R; i < nrows; ++i) {
-            heap.clear();
-            for (cidx_t j : inst.rows[i])
-                heap.try_insert(j);
-            for (cidx_t j : heap) {
+        for (auto const& local_idxs : thread_idxs)
+            for (cidx_t j : local_idxs)
                 if (!taken_idxs[j]) {
                     taken_idxs[j] = true;
                     idxs.push_back(j);
                 }
-            }
-        }
     }
 
-    static void _init_partial_instance(Instance const&            inst,      // in
-                                       std::vector<cidx_t> const& idxs,      // in
-                                       Instance&                  core_inst  // inout
+    // The core can be updated only if it is exactly the one built by the last call on the same
+    // (unchanged) instance. Fixing always removes columns, so it is caught by the size checks.
+    bool _is_prev_core(Instance const& inst, InstAndMap const& core) const {
+        return prev_inst == &inst && prev_ncols == csize(inst.cols) &&
+               prev_nnz == inst.cols.idxs.size() && prev_col_map == core.col_map &&
+               csize(core.inst.cols) == csize(core.col_map);
+    }
+
+    static void _init_partial_instance(Instance const&            inst,     // in
+                                       std::vector<cidx_t> const& col_map,  // in
+                                       InstAndMap&                core      // inout
     ) {
         // Clean up the current core instance.
-        core_inst.cols.clear();
-        core_inst.rows.clear();
-        core_inst.costs.clear();
-        for (cidx_t j : idxs)
-            push_back_col_from(inst, j, core_inst);  // Add column to core_inst
+        core.inst.cols.clear();
+        core.inst.rows.clear();
+        core.inst.costs.clear();
+        for (cidx_t j : col_map)
+            push_back_col_from(inst, j, core.inst);  // Add column to core_inst
+        core.col_map = col_map;
+    }
+
+    // Successive cores share most of their columns: columns that are still selected are compacted
+    // inplace, and only the newly selected ones are copied from the original instance.
+    static void _update_partial_instance(Instance const&            inst,        // in
+                                         std::vector<cidx_t> const& col_map,     // in
+                                         std::vector<bool>&         taken_idxs,  // inout
+                                         InstAndMap&                core         // inout
+    ) {
+        auto& cols = core.inst.cols;  // shorthand
+
+        cidx_t w = 0_C;
+        size_t n = 0;
+        for (cidx_t k = 0_C; k < csize(core.col_map); ++k) {
+            cidx_t j = core.col_map[k];
+            if (!taken_idxs[j])
+                continue;
+            taken_idxs[j] = false;  // already in core
+
+            size_t beg   = cols.begs[k];
+            size_t end   = cols.begs[k + 1_C];
+            cols.begs[w] = n;  // w <= k, so begs[k + 1] is still untouched
+            for (size_t x = beg; x < end; ++x)
+                cols.idxs[n++] = cols.idxs[x];
+            core.inst.costs[w] = core.inst.costs[k];
+            core.col_map[w]    = j;
+            ++w;
+        }
+        cols.begs[w] = n;
+        cols.begs.resize(w + 1_C);
+        cols.idxs.resize(n);
+        core.inst.costs.resize(w);
+        core.col_map.resize(w);
+
+        for (cidx_t j : col_map)
+            if (taken_idxs[j]) {
+                push_back_col_from(inst, j, core.inst);
+                core.col_map.push_back(j);
+            }
     }
 };
 
@@ -17,6 +17,7 @@
 #include "utils/CoverCounters.hpp"
 #include "utils/assert.hpp"  // IWYU pragma:  keep
 #include "utils/limits.hpp"
+#include "utils/parallel.hpp"
 #include "utils/print.hpp"
 #include "utils/utility.hpp"
 
@@ -25,20 +26,37 @@ namespace cft {
 // Subgradient phase of the 3-phase algorithm.
 class Subgradient {
     // Caches
-    Solution            lb_sol;         // Partial solution with negative reduced costs
-    Solution            greedy_sol;     // Greedy solution
-    CoverCounters       row_coverage;   // Row coverage
-    std::vector<real_t> reduced_costs;  // Reduced costs vector
-    std::vector<real_t> lagr_mult;      // Lagrangian multipliers
+    Solution            lb_sol;            // Partial solution with negative reduced costs
+    Solution            greedy_sol;        // Greedy solution
+    CoverCounters       row_coverage;      // Row coverage
+    std::vector<real_t> reduced_costs;     // Reduced costs vector
+    std::vector<real_t> lagr_mult;         // Lagrangian multipliers
+    std::vector<real_t> mult_delta;        // Multiplier changes of the last update
+    real_t              mult_sum = 0.0_F;  // Sum of lagr_mult, kept by the multiplier update
+
+    // Snapshot of a heuristic iteration, taken right before its greedy call.
+    struct HeurSlot {
+        std::vector<real_t> lagr_mult;         // Multipliers given to the greedy
+        std::vector<real_t> reduced_costs;     // Reduced costs given to the greedy
+        CoverCounters       row_coverage;      // Subgradient row coverage
+        real_t              mult_sum = 0.0_F;  // Sum of lagr_mult
+        real_t              lb       = 0.0_F;
+        real_t              sqr_norm = 0.0_F;
+        bool                stop     = false;  // The sequential loop returns before the greedy
+        Solution            sol;               // Greedy solution
+        Greedy              greedy;            // Greedy cache
+    };
+    std::vector<HeurSlot> heur_slots;
 
 public:
-    real_t operator()(Environment const&   env,            // in
-                      Instance const&      orig_inst,      // in
-                      real_t               cutoff,         // in
-                      Pricer               price,          // cache
-                      InstAndMap&          core,           // inout
-                      real_t&              step_size,      // inout
-                      std::vector<real_t>& best_lagr_mult  // inout
+    real_t operator()(Environment const&   env,                // in
+                      Instance const&      orig_inst,          // in
+                      real_t               cutoff,             // in
+                      Pricer&              price,              // cache
+                      InstAndMap&          core,               // inout
+                      real_t&              step_size,          // inout
+                      std::vector<real_t>& best_lagr_mult,     // inout
+                      size_t               exit_period = 300   // in
     ) {
         size_t const nrows       = size(orig_inst.rows);
         real_t const max_real_lb = cutoff - env.epsilon;
@@ -47,23 +65,33 @@ public:
         assert(!core.inst.cols.empty() && "Empty core instance");
         assert(nrows == size(core.inst.rows) && "Incompatible instances");
 
+        ProfileScope prof_scope(env.profile.subgradient);
+
         auto   timer          = Chrono<>();
         auto   next_step_size = local::StepSizeManager(20, step_size);
-        auto   should_exit    = local::ExitConditionManager(300);
+        auto   should_exit    = local::ExitConditionManager(exit_period);
         auto   should_price   = local::PricingManager(10ULL, min(1000ULL, nrows / 3ULL));
         real_t best_core_lb   = limits<real_t>::min();
         auto   best_real_lb   = limits<real_t>::min();
         _reset_lower_bounds(lb_sol, best_core_lb);
         lagr_mult = best_lagr_mult;
+        mult_sum  = local::sum_lagr_mult(lagr_mult);
 
         print<4>(env, "SUBG> Subgradient start: UB {:.2f}, cutoff {:.2f}\n", cutoff, max_real_lb);
 
-        size_t max_iters = 10ULL * nrows;
+        size_t max_iters      = 10ULL * nrows;
+        bool   live_red_costs = false;  // reduced_costs match lagr_mult and core.inst
         for (size_t iter = 0; iter < max_iters && best_real_lb < max_real_lb; ++iter) {
-
-            _update_lbsol_and_reduced_costs(core.inst, lagr_mult, lb_sol, reduced_costs);
+            ++env.profile.subgradient.work;
+
+            if (live_red_costs && !_refresh_red_costs(env, iter))
+                _update_lbsol(mult_sum, reduced_costs, lb_sol);
+            else
+                _update_lbsol_and_reduced_costs(
+                    core.inst, lagr_mult, mult_sum, lb_sol, reduced_costs);
+            live_red_costs = true;
             _compute_reduced_row_coverage(core.inst, reduced_costs, row_coverage, lb_sol);
-            real_t sqr_norm = _compute_subgrad_sqr_norm(row_coverage);
+            real_t sqr_norm = local::subgrad_sqr_norm(row_coverage);
 
             if (lb_sol.cost > best_core_lb) {
                 print<5>(env, "SUBG> {:4}: Current lower bound: {:.2f}\n", iter, lb_sol.cost);
@@ -74,6 +102,8 @@ public:
             if (sqr_norm < 0.999_F) {  // Squared norm is an integer
                 print<4>(env, "SUBG> {:4}: Found optimal solution.\n", iter);
                 best_lagr_mult = lagr_mult;
+                if (best_real_lb == limits<real_t>::min())  // Before the first pricing
+                    best_real_lb = price(env, orig_inst, best_lagr_mult, core);
                 break;
             }
 
@@ -82,10 +112,11 @@ public:
 
             step_size          = next_step_size(iter, lb_sol.cost);
             real_t step_factor = step_size * (cutoff - lb_sol.cost) / sqr_norm;
-            _update_lagr_mult(row_coverage, step_factor, lagr_mult);
+            _update_lagr_mult(env, core.inst, row_coverage, step_factor);
 
             if (should_price(iter) && iter < max_iters - 1) {
-                real_t real_lb = price(orig_inst, lagr_mult, core);
+                real_t real_lb = price(env, orig_inst, lagr_mult, core);
+                live_red_costs = false;  // core has changed
                 should_price.update(best_core_lb, real_lb, cutoff);
 
                 print<4>(env,
@@ -97,12 +128,18 @@ public:
 
                 best_real_lb = max(best_real_lb, real_lb);
                 _reset_lower_bounds(lb_sol, best_core_lb);
-
-                if (env.timer.elapsed<sec>() > env.time_limit)
-                    break;
             }
+
+            // Checked at every iteration, pricing points can be up to a thousand iterations apart
+            if (stop_requested(env))
+                break;
         }
 
+        // A stop request can end the loop before the first pricing, which would delay the stop by
+        // a pass over the whole instance, or right after it, with multipliers far from good ones
+        // and a negative bound. With non-negative costs, zero is a valid bound anyway.
+        best_real_lb = max(best_real_lb, 0.0_F);
+
         print<4>(env, "SUBG> Subgradient ended in {:.2f}s\n\n", timer.elapsed<sec>());
         return best_real_lb;
     }
@@ -119,18 +156,32 @@ public:
                    Solution&            best_sol,       // inout
                    std::vector<real_t>& best_lagr_mult  // inout
     ) {
+        ProfileScope prof_scope(env.profile.heuristic);
+        if (env.nthreads > 1) {
+            _batched_heuristic(env, core_inst, step_size, best_sol, best_lagr_mult);
+            for (HeurSlot& slot : heur_slots)
+                slot.greedy.flush_profile(env.profile);
+            return;
+        }
+
         auto   timer        = Chrono<>();
         real_t best_core_lb = limits<real_t>::min();
         _reset_lower_bounds(lb_sol, best_core_lb);
         lagr_mult = best_lagr_mult;
+        mult_sum  = local::sum_lagr_mult(lagr_mult);
 
         for (size_t iter = 0; iter < env.heur_iters; ++iter) {
+            ++env.profile.heuristic.work;
 
-            _update_lbsol_and_reduced_costs(core_inst, lagr_mult, lb_sol, reduced_costs);
+            if (!_refresh_red_costs(env, iter))
+                _update_lbsol(mult_sum, reduced_costs, lb_sol);
+            else
+                _update_lbsol_and_reduced_costs(
+                    core_inst, lagr_mult, mult_sum, lb_sol, reduced_costs);
             row_coverage.reset(rsize(core_inst.rows));
             for (cidx_t j : lb_sol.idxs)
                 row_coverage.cover(core_inst.cols[j]);
-            real_t sqr_norm = _compute_subgrad_sqr_norm(row_coverage);
+            real_t sqr_norm = local::subgrad_sqr_norm(row_coverage);
 
             if (lb_sol.cost > best_core_lb) {
                 best_core_lb   = lb_sol.cost;
@@ -151,16 +202,17 @@ public:
             }
 
             if (sqr_norm < 0.999_F) {  // Squared norm is an integer
-                assert(best_core_lb <= best_sol.cost && "Optimum is above cutoff");
+                // lb_sol is a cover, but its cost goes through the multipliers and can round above
+                assert(best_core_lb <= best_sol.cost + env.epsilon && "Optimum is above cutoff");
                 print<4>(env, "HEUR> {:4} Found optimal solution.\n", iter);
                 best_lagr_mult = lagr_mult;
                 return;
             }
 
             real_t step_factor = step_size * (best_sol.cost - lb_sol.cost) / sqr_norm;
-            _update_lagr_mult(row_coverage, step_factor, lagr_mult);
+            _update_lagr_mult(env, core_inst, row_coverage, step_factor);
 
-            if (env.timer.elapsed<sec>() > env.time_limit)
+            if (stop_requested(env))
                 break;
         }
 
@@ -168,6 +220,113 @@ public:
     }
 
 private:
+    // Same as the sequential heuristic, but the greedy calls of up to nthreads iterations run
+    // concurrently. The multipliers of the batch are computed first, assuming that the best
+    // solution does not change. Iterations are then committed in order: when a greedy call
+    // improves the best solution, the multiplier update of that iteration is redone with the new
+    // cost and the rest of the batch is discarded, so the trajectory matches the sequential one.
+    void _batched_heuristic(Environment const&   env,            // in
+                            Instance const&      core_inst,      // in
+                            real_t               step_size,      // in
+                            Solution&            best_sol,       // inout
+                            std::vector<real_t>& best_lagr_mult  // inout
+    ) {
+        auto   timer        = Chrono<>();
+        real_t best_core_lb = limits<real_t>::min();
+        _reset_lower_bounds(lb_sol, best_core_lb);
+        lagr_mult = best_lagr_mult;
+        mult_sum  = local::sum_lagr_mult(lagr_mult);
+        heur_slots.resize(checked_cast<size_t>(env.nthreads));
+        for (HeurSlot& slot : heur_slots)
+            slot.greedy.set_enum_limits(env.enum_vars, env.enum_nodes);
+
+        size_t iter = 0;
+        while (iter < env.heur_iters) {
+
+            // Speculative multipliers
+            size_t nslots  = 0;
+            real_t spec_lb = best_core_lb;
+            while (nslots < heur_slots.size() && iter + nslots < env.heur_iters) {
+                if (!_refresh_red_costs(env, iter + nslots))
+                    _update_lbsol(mult_sum, reduced_costs, lb_sol);
+                else
+                    _update_lbsol_and_reduced_costs(
+                        core_inst, lagr_mult, mult_sum, lb_sol, reduced_costs);
+
+                HeurSlot& slot = heur_slots[nslots++];
+                slot.row_coverage.reset(rsize(core_inst.rows));
+                for (cidx_t j : lb_sol.idxs)
+                    slot.row_coverage.cover(core_inst.cols[j]);
+                slot.sqr_norm      = local::subgrad_sqr_norm(slot.row_coverage);
+                slot.lb            = lb_sol.cost;
+                slot.lagr_mult     = lagr_mult;
+                slot.mult_sum      = mult_sum;
+                slot.reduced_costs = reduced_costs;
+
+                spec_lb   = max(spec_lb, lb_sol.cost);
+                slot.stop = spec_lb >= best_sol.cost - env.epsilon;
+                if (slot.stop || slot.sqr_norm < 0.999_F)
+                    break;
+
+                real_t step_factor = step_size * (best_sol.cost - slot.lb) / slot.sqr_norm;
+                _update_lagr_mult(env, core_inst, slot.row_coverage, step_factor);
+            }
+
+            real_t cutoff = best_sol.cost;
+            parallel_run(nslots, [&](size_t s) {
+                HeurSlot& slot = heur_slots[s];
+                slot.sol.idxs.clear();
+                slot.sol.cost = limits<real_t>::max();
+                if (!slot.stop)
+                    slot.sol.cost = slot.greedy(
+                        core_inst, slot.lagr_mult, slot.reduced_costs, slot.sol.idxs, cutoff);
+            });
+
+            // Commit in order
+            for (size_t s = 0; s < nslots; ++s, ++iter) {
+                HeurSlot& slot = heur_slots[s];
+                ++env.profile.heuristic.work;
+                if (slot.lb > best_core_lb) {
+                    best_core_lb   = slot.lb;
+                    best_lagr_mult = slot.lagr_mult;
+                }
+                if (slot.stop)
+                    return;
+
+                print<5>(env, "HEUR> {:4}: Greedy solution {:.2f}\n", iter, best_sol.cost);
+                bool improved = slot.sol.cost <= best_sol.cost - env.epsilon;
+                if (improved) {
+                    best_sol = slot.sol;
+                    print<4>(env, "HEUR> {:4}: Improved solution {:.2f}\n", iter, best_sol.cost);
+                    CFT_IF_DEBUG(check_inst_solution(core_inst, best_sol));
+                }
+
+                if (slot.sqr_norm < 0.999_F) {  // Squared norm is an integer
+                    assert(best_core_lb <= best_sol.cost + env.epsilon &&
+                           "Optimum is above cutoff");
+                    print<4>(env, "HEUR> {:4} Found optimal solution.\n", iter);
+                    best_lagr_mult = slot.lagr_mult;
+                    return;
+                }
+
+                if (improved) {  // The following slots used the old cost, redo from here
+                    lagr_mult          = slot.lagr_mult;
+                    mult_sum           = slot.mult_sum;
+                    reduced_costs      = slot.reduced_costs;
+                    real_t step_factor = step_size * (best_sol.cost - slot.lb) / slot.sqr_norm;
+                    _update_lagr_mult(env, core_inst, slot.row_coverage, step_factor);
+                    ++iter;
+                    break;
+                }
+            }
+
+            if (stop_requested(env))
+                break;
+        }
+
+        print<4>(env, "HEUR> Heuristic phase ended in {:.2f}s\n\n", timer.elapsed<sec>());
+    }
+
     // Initialize lower-bounds and reduced costs as if lagr_mult were 0s. NOTE: This function
     // assumes to be called just before the start of a new iteration of the subgradient loop. In
     // this location, reduced_costs and lb_sol have the values corresponding to lagr_mult = 0s,
@@ -181,38 +340,61 @@ private:
         lb_sol.idxs.clear();
     }
 
-    static void _update_lagr_mult(CoverCounters const& row_coverage,  // in
-                                  real_t               step_factor,   // in
-                                  std::vector<real_t>& lagr_mult      // inout
-    ) {
-        for (ridx_t i = 0_R; i < rsize(row_coverage); ++i) {
-            auto violation = 1.0_F - as_real(row_coverage[i]);
+    // Reduced costs are kept up to date through the rows whose multiplier changed, and fully
+    // recomputed every env.red_costs_period iterations to bound the floating point drift. With a
+    // period of 1 they are recomputed at every iteration and never updated in place.
+    static bool _refresh_red_costs(Environment const& env, size_t iter) {
+        return env.red_costs_period <= 1 || iter % env.red_costs_period == 0;
+    }
 
-            real_t old_mult   = lagr_mult[i];
-            real_t delta_mult = step_factor * violation;
+    // Only rows not covered exactly once change their multiplier. The fused row sweep updates
+    // lagr_mult and mult_sum, then (unless live updates are disabled) the changes are applied to
+    // the reduced costs of the columns in the changed rows, so that they stay in sync.
+    void _update_lagr_mult(Environment const&   env,         // in
+                           Instance const&      inst,        // in
+                           CoverCounters const& coverage,    // in
+                           real_t               step_factor  // in
+    ) {
+        mult_sum = local::update_lagr_mult(coverage, step_factor, lagr_mult, mult_delta);
+        if (env.red_costs_period > 1)
+            local::apply_mult_delta(inst, mult_delta, reduced_costs);
+    }
 
-            // Clamp to avoid numerical issues
-            lagr_mult[i] = clamp(old_mult + delta_mult, 0.0_F, 1e6_F);
-            assert(std::isfinite(lagr_mult[i]) && "Multiplier is not finite");
+    // Lower bound solution from reduced costs that are already up to date.
+    static void _update_lbsol(real_t                     mult_sum,       // in
+                              std::vector<real_t> const& reduced_costs,  // in
+                              Solution&                  lb_sol          // out
+    ) {
+        lb_sol.cost = mult_sum;
+
+        lb_sol.idxs.resize(reduced_costs.size());
+        size_t n = 0;
+        for (cidx_t j = 0_C; j < csize(reduced_costs); ++j) {
+            lb_sol.idxs[n] = j;
+            n += static_cast<size_t>(reduced_costs[j] < 0.0_F);
+            lb_sol.cost += min(reduced_costs[j], 0.0_F);
         }
+        lb_sol.idxs.resize(n);
     }
 
     static void _update_lbsol_and_reduced_costs(Instance const&            inst,          // in
                                                 std::vector<real_t> const& lagr_mult,     // in
+                                                real_t                     mult_sum,      // in
                                                 Solution&                  lb_sol,        // out
                                                 std::vector<real_t>&       reduced_costs  // out
     ) {
-        lb_sol.idxs.clear();
-        lb_sol.cost = 0.0_F;
-        for (real_t const value : lagr_mult)
-            lb_sol.cost += value;
+        lb_sol.cost = mult_sum;
 
+        // Branchless: every column is written, but the end of the list only advances for columns
+        // with negative reduced cost.
+        lb_sol.idxs.resize(inst.cols.size());
+        size_t n = 0;
         compute_reduced_costs(inst, lagr_mult, reduced_costs, [&](real_t red_cost, cidx_t j) {
-            if (red_cost < 0.0_F) {
-                lb_sol.idxs.push_back(j);
-                lb_sol.cost += red_cost;
-            }
+            lb_sol.idxs[n] = j;
+            n += static_cast<size_t>(red_cost < 0.0_F);
+            lb_sol.cost += min(red_cost, 0.0_F);
         });
+        lb_sol.idxs.resize(n);
     }
 
     // Computes the row coverage of the given solution by including the best non-redundant columns.
@@ -230,16 +412,6 @@ private:
                 row_coverage.cover(col);
         }
     }
-
-    // Computes the subgradient squared sqr_norm according to the given row coverage.
-    static real_t _compute_subgrad_sqr_norm(CoverCounters const& row_coverage) {
-        int64_t sqr_norm = 0;
-        for (ridx_t i = 0_R; i < rsize(row_coverage); ++i) {
-            int64_t violation = 1 - checked_cast<int64_t>(row_coverage[i]);
-            sqr_norm += violation * violation;
-        }
-        return as_real(sqr_norm);
-    }
 };
 }  // namespace cft
 
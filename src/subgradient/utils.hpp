@@ -5,9 +5,14 @@
 #define CFT_SRC_SUBGRADIENT_UTILS_HPP
 
 
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <vector>
 
+#include "core/Instance.hpp"
 #include "core/cft.hpp"
+#include "utils/CoverCounters.hpp"
 #include "utils/assert.hpp"  // IWYU pragma:  keep
 #include "utils/limits.hpp"
 #include "utils/utility.hpp"
@@ -113,6 +118,97 @@ namespace cft { namespace local { namespace {
         }
     };
 
+    // Squared norm of the subgradient, i.e., sum of (1 - coverage)^2 over the rows. Computed on
+    // unsigned 32x32->64 bit products so that the loop vectorizes.
+    inline real_t subgrad_sqr_norm(CoverCounters const& row_coverage) {
+        uint64_t sqr_norm = 0;
+        for (CoverCounters::counter_t cov : row_coverage.cov_counters) {
+            uint64_t violation = cov > 0U ? cov - 1U : 1U;  // |1 - cov|
+            sqr_norm += violation * violation;
+        }
+        return as_real(sqr_norm);
+    }
+
+    // Multiplier sums are accumulated in this many independent lanes, so that they vectorize.
+    constexpr size_t mult_sum_lanes = 8;
+
+    inline real_t reduce_lanes(real_t const (&lanes)[mult_sum_lanes]) {
+        real_t sum = 0.0_F;
+        for (real_t lane : lanes)
+            sum += lane;
+        return sum;
+    }
+
+    // Subgradient step on one row: returns the new multiplier and stores its change in delta.
+    // Rows covered exactly once keep their multiplier.
+    inline real_t update_row_mult(CoverCounters::counter_t cov,          // in
+                                  real_t                   step_factor,  // in
+                                  real_t&                  mult,         // inout
+                                  real_t&                  delta         // out
+    ) {
+        real_t violation = 1.0_F - as_real(cov);
+        real_t old_mult  = mult;
+        real_t new_mult  = clamp(old_mult + step_factor * violation, 0.0_F, 1e6_F);
+        new_mult         = violation == 0.0_F ? old_mult : new_mult;
+        mult             = new_mult;
+        delta            = new_mult - old_mult;
+        return new_mult;
+    }
+
+    // Fused multiplier update: a single branchless sweep over the contiguous coverage and
+    // multiplier arrays computes the new clamped multipliers, their changes (to be applied to the
+    // reduced costs) and their sum, which is returned.
+    inline real_t update_lagr_mult(CoverCounters const& row_coverage,  // in
+                                   real_t               step_factor,   // in
+                                   std::vector<real_t>& lagr_mult,     // inout
+                                   std::vector<real_t>& mult_delta     // out
+    ) {
+        size_t const nrows = row_coverage.size();
+        assert(lagr_mult.size() == nrows && "Invalid multipliers size");
+        mult_delta.resize(nrows);
+        CoverCounters::counter_t const* cov   = row_coverage.cov_counters.data();
+        real_t*                         mult  = lagr_mult.data();
+        real_t*                         delta = mult_delta.data();
+
+        real_t lanes[mult_sum_lanes] = {};
+        size_t i                     = 0;
+        for (; i + mult_sum_lanes <= nrows; i += mult_sum_lanes)
+            for (size_t l = 0; l < mult_sum_lanes; ++l)
+                lanes[l] += update_row_mult(cov[i + l], step_factor, mult[i + l], delta[i + l]);
+        for (; i < nrows; ++i)
+            lanes[0] += update_row_mult(cov[i], step_factor, mult[i], delta[i]);
+
+        real_t mult_sum = reduce_lanes(lanes);
+        assert(std::isfinite(mult_sum) && "Multiplier is not finite");
+        return mult_sum;
+    }
+
+    // Applies the multiplier changes of update_lagr_mult to the reduced costs, through the rows
+    // whose multiplier actually changed.
+    inline void apply_mult_delta(Instance const&            inst,          // in
+                                 std::vector<real_t> const& mult_delta,    // in
+                                 std::vector<real_t>&       reduced_costs  // inout
+    ) {
+        for (ridx_t i = 0_R; i < rsize(mult_delta); ++i)
+            if (mult_delta[i] != 0.0_F)
+                for (cidx_t j : inst.rows[i])
+                    reduced_costs[j] -= mult_delta[i];
+    }
+
+    // Sum of the multipliers, accumulated as in update_lagr_mult.
+    inline real_t sum_lagr_mult(std::vector<real_t> const& lagr_mult) {
+        size_t const nrows = lagr_mult.size();
+
+        real_t lanes[mult_sum_lanes] = {};
+        size_t i                     = 0;
+        for (; i + mult_sum_lanes <= nrows; i += mult_sum_lanes)
+            for (size_t l = 0; l < mult_sum_lanes; ++l)
+                lanes[l] += lagr_mult[i + l];
+        for (; i < nrows; ++i)
+            lanes[0] += lagr_mult[i];
+        return reduce_lanes(lanes);
+    }
+
 }  // namespace
 }  // namespace local
 }  // namespace cft
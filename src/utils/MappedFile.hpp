@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef CFT_SRC_UTILS_MAPPEDFILE_HPP
+#define CFT_SRC_UTILS_MAPPEDFILE_HPP
+
+
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CFT_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <vector>
+#endif
+
+#include "utils/StringView.hpp"
+
+namespace cft {
+
+// Read-only view of a whole file. On POSIX systems the file is memory-mapped, so its content is
+// paged in lazily and never copied. Elsewhere, it falls back to reading the file into a buffer.
+class MappedFile {
+    char const* start = nullptr;
+    size_t      sz    = 0;
+#ifndef CFT_HAS_MMAP
+    std::vector<char> buffer;
+#endif
+
+public:
+    explicit MappedFile(std::string const& path) {
+#ifdef CFT_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::invalid_argument(fmt::format("Cannot open file {}", path));
+
+        struct stat st = {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::invalid_argument(fmt::format("Cannot stat file {}", path));
+        }
+
+        sz = static_cast<size_t>(st.st_size);
+        if (sz > 0) {
+            void* addr = ::mmap(nullptr, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error(fmt::format("Cannot map file {}", path));
+            }
+            start = static_cast<char const*>(addr);
+            ::madvise(addr, sz, MADV_SEQUENTIAL);
+        }
+        ::close(fd);  // The mapping stays valid after closing the descriptor
+#else
+        auto in = std::ifstream(path, std::ios::binary);
+        if (!in.is_open())
+            throw std::invalid_argument(fmt::format("Cannot open file {}", path));
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        start = buffer.data();
+        sz    = buffer.size();
+#endif
+    }
+
+    MappedFile(MappedFile const&)            = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : start(other.start)
+        , sz(other.sz)
+#ifndef CFT_HAS_MMAP
+        , buffer(std::move(other.buffer))
+#endif
+    {
+        other.start = nullptr;
+        other.sz    = 0;
+    }
+
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    ~MappedFile() {
+#ifdef CFT_HAS_MMAP
+        if (start != nullptr)
+            ::munmap(const_cast<char*>(start), sz);
+#endif
+    }
+
+    char const* data() const {
+        return start;
+    }
+
+    size_t size() const {
+        return sz;
+    }
+
+    StringView view() const {
+        return {start, sz};
+    }
+};
+
+}  // namespace cft
+
+
+#endif /* CFT_SRC_UTILS_MAPPEDFILE_HPP */
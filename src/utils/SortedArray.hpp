@@ -32,6 +32,10 @@ struct SortedArray : Key /*EBO*/ {
         return sz;
     }
 
+    static constexpr size_type capacity() {
+        return Nm;
+    }
+
     T const& back() const {
         assert(sz > 0);
         return data[sz - 1];
@@ -55,6 +55,14 @@ struct SparseBinMat {
         idxs.insert(idxs.end(), elem.begin(), elem.end());
         begs.push_back(idxs.size());
     }
+
+    bool operator==(SparseBinMat const& other) const {
+        return begs == other.begs && idxs == other.idxs;
+    }
+
+    bool operator!=(SparseBinMat const& other) const {
+        return !(*this == other);
+    }
 };
 
 
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef CFT_SRC_UTILS_SPSCQUEUE_HPP
+#define CFT_SRC_UTILS_SPSCQUEUE_HPP
+
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cft {
+
+// Bounded lock-free queue for one producer and one consumer thread. Slots are allocated once and
+// reused: pushing copy-assigns into a slot and popping swaps it out, so elements owning memory
+// (e.g., vectors) keep recycling the same buffers instead of allocating at every push.
+// Several producers can share the queue as long as they serialize their pushes (e.g., by a lock).
+template <typename T>
+class SpscQueue {
+    std::vector<T>      slots;
+    std::atomic<size_t> head{0};  // Pop counter, written by the consumer only
+    std::atomic<size_t> tail{0};  // Push counter, written by the producer only
+
+public:
+    explicit SpscQueue(size_t capacity)
+        : slots(capacity > 0 ? capacity : 1) {
+    }
+
+    size_t capacity() const {
+        return slots.size();
+    }
+
+    // Producer side. Returns false (leaving the queue untouched) if the queue is full.
+    bool try_push(T const& val) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == slots.size())
+            return false;
+        slots[t % slots.size()] = val;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false (leaving val untouched) if the queue is empty.
+    bool try_pop(T& val) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false;
+        using std::swap;
+        swap(val, slots[h % slots.size()]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+}  // namespace cft
+
+
+#endif /* CFT_SRC_UTILS_SPSCQUEUE_HPP */
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef CFT_SRC_UTILS_STRINGMAP_HPP
+#define CFT_SRC_UTILS_STRINGMAP_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "utils/StringView.hpp"
+
+namespace cft {
+
+// FNV-1a hash of a string view
+inline uint64_t fnv1a_hash(StringView str) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Insert-only hash map from strings to values, queried directly with StringView keys. Keys are
+// copied into a single character pool and slots use open addressing with linear probing, so
+// lookups never allocate and insertions allocate only when the pool or the table grows.
+template <typename ValT>
+class StringMap {
+    static constexpr size_t empty_slot = ~size_t{0};
+
+    struct Slot {
+        uint64_t hash;
+        size_t   key_beg;  // Offset of the key in the pool, empty_slot if unused
+        size_t   key_size;
+        ValT     val;
+    };
+
+    std::vector<char> pool;
+    std::vector<Slot> slots;
+    size_t            count = 0;
+
+public:
+    StringMap() {
+        _rehash(16);
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    ValT const* find(StringView key) const {
+        size_t s = _find_slot(key, fnv1a_hash(key));
+        return slots[s].key_beg == empty_slot ? nullptr : &slots[s].val;
+    }
+
+    // Returns false (and leaves the map untouched) if the key is already present
+    bool insert(StringView key, ValT val) {
+        if (2 * (count + 1) > slots.size())
+            _rehash(2 * slots.size());
+
+        uint64_t hash = fnv1a_hash(key);
+        size_t   s    = _find_slot(key, hash);
+        if (slots[s].key_beg != empty_slot)
+            return false;
+
+        slots[s] = {hash, pool.size(), key.size(), val};
+        pool.insert(pool.end(), key.begin(), key.end());
+        ++count;
+        return true;
+    }
+
+private:
+    StringView _key(Slot const& slot) const {
+        return {pool.data() + slot.key_beg, slot.key_size};
+    }
+
+    size_t _find_slot(StringView key, uint64_t hash) const {
+        size_t mask = slots.size() - 1;
+        size_t s    = static_cast<size_t>(hash) & mask;
+        while (slots[s].key_beg != empty_slot &&
+               (slots[s].hash != hash || _key(slots[s]) != key))
+            s = (s + 1) & mask;
+        return s;
+    }
+
+    void _rehash(size_t new_size) {
+        auto old_slots = std::vector<Slot>(new_size, Slot{0, empty_slot, 0, ValT{}});
+        old_slots.swap(slots);
+
+        size_t mask = slots.size() - 1;
+        for (auto const& slot : old_slots) {
+            if (slot.key_beg == empty_slot)
+                continue;
+            size_t s = static_cast<size_t>(slot.hash) & mask;
+            while (slots[s].key_beg != empty_slot)
+                s = (s + 1) & mask;
+            slots[s] = slot;
+        }
+    }
+};
+
+}  // namespace cft
+
+
+#endif /* CFT_SRC_UTILS_STRINGMAP_HPP */
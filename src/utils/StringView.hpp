@@ -142,11 +142,11 @@ struct StringView {
     }
 
     bool operator==(StringView rhs) const {
-        return compare(rhs) == 0;
+        return size() == rhs.size() && (empty() || std::memcmp(start, rhs.start, size()) == 0);
     }
 
     bool operator!=(StringView rhs) const {
-        return compare(rhs) != 0;
+        return !(*this == rhs);
     }
 
     bool operator<(StringView rhs) const {
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef CFT_SRC_UTILS_PARALLEL_HPP
+#define CFT_SRC_UTILS_PARALLEL_HPP
+
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace cft {
+
+// Fork-join helper: runs func(tid) for each tid in [0, nthreads), the calling thread takes tid 0.
+// Returns when all the calls are done. If any call throws, the exception of the lowest tid is
+// rethrown in the calling thread.
+template <typename Func>
+void parallel_run(size_t nthreads, Func func) {
+    if (nthreads <= 1) {
+        func(size_t{0});
+        return;
+    }
+
+    auto errors  = std::vector<std::exception_ptr>(nthreads);
+    auto wrapped = [&](size_t tid) {
+        try {
+            func(tid);
+        } catch (...) {
+            errors[tid] = std::current_exception();
+        }
+    };
+
+    auto threads = std::vector<std::thread>();
+    threads.reserve(nthreads - 1);
+    for (size_t tid = 1; tid < nthreads; ++tid)
+        threads.emplace_back(wrapped, tid);
+    wrapped(size_t{0});
+    for (auto& thread : threads)
+        thread.join();
+
+    for (auto const& err : errors)
+        if (err)
+            std::rethrow_exception(err);
+}
+
+}  // namespace cft
+
+
+#endif /* CFT_SRC_UTILS_PARALLEL_HPP */
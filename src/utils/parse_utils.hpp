@@ -9,26 +9,33 @@
 
 #include <cerrno>
 #include <cstddef>
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
 
+#include "utils/MappedFile.hpp"
 #include "utils/StringView.hpp"
 #include "utils/limits.hpp"
 #include "utils/utility.hpp"
 
 namespace cft {
 
+// Same as std::isspace in the "C" locale, but inlined. Parsing spends most of its time here.
+inline bool is_space(char c) {
+    return c == ' ' || ('\t' <= c && c <= '\r');
+}
+
 struct IsSpace {
     bool operator()(char c) const {
-        return std::isspace(c) != 0;
+        return is_space(c);
     }
 };
 
 struct NotSpace {
     bool operator()(char c) const {
-        return std::isspace(c) == 0;
+        return !is_space(c);
     }
 };
 
@@ -59,6 +66,15 @@ inline std::vector<StringView> split(StringView str) {
     return elems;
 }
 
+// Removes and returns the first whitespace-separated token of str (empty if none is left). Unlike
+// split, it does not allocate.
+inline StringView consume_token(StringView& str) {
+    auto   trimmed  = ltrim(str);
+    size_t tok_size = trimmed.find_first_true(IsSpace{});
+    str             = trimmed.remove_prefix(tok_size);
+    return trimmed.get_substr(0, tok_size);
+}
+
 // Parse a string to a specific native scalar type
 template <typename T>
 struct string_to {
@@ -113,6 +129,112 @@ struct string_to {
     }
 };
 
+// Bounded and allocation-free counterpart of string_to. It never reads past the end of the view,
+// so it can be used on buffers that are not null-terminated (e.g., memory-mapped files). Plain
+// decimal numbers are scanned by hand; anything else (exponents, very long mantissas, inf, nan,
+// hex floats) is delegated to string_to through a null-terminated copy of the token.
+template <typename T>
+struct fast_string_to {
+    using val_t = native_t<T>;
+    static_assert(std::is_integral<val_t>::value || std::is_floating_point<val_t>::value,
+                  "Only integral and floating point types are supported");
+
+    // Parse without modifying the string view  (note the pass by value)
+    static T parse(StringView str) {
+        return consume(str);
+    }
+
+    // Parse and modify the string view removing the element parsed
+    static T consume(StringView& str) {
+        char const* ptr = str.begin();
+        while (ptr != str.end() && is_space(*ptr))
+            ++ptr;
+        str = StringView(ptr, str.end());
+        return std::is_floating_point<val_t>::value ? _consume_real(str) : _consume_integer(str);
+    }
+
+private:
+    static bool _is_digit(char c) {
+        return '0' <= c && c <= '9';
+    }
+
+    // Scans up to 19 digits into an unsigned accumulator, returns the number of digits read.
+    static size_t _scan_digits(char const*& ptr, char const* end, uint64_t& acc) {
+        size_t ndigits = 0;
+        for (; ptr != end && _is_digit(*ptr) && ndigits < 19; ++ptr, ++ndigits)
+            acc = acc * 10U + static_cast<uint64_t>(*ptr - '0');
+        return ndigits;
+    }
+
+    static T _fallback(StringView& str) {
+        size_t tok_size = str.find_first_true(IsSpace{});
+        auto   token    = std::string(str.begin(), str.begin() + tok_size);
+        auto   tok_view = StringView(token);
+        T      val      = string_to<T>::consume(tok_view);
+        str = str.remove_prefix(tok_size - tok_view.size());
+        return val;
+    }
+
+    static T _consume_integer(StringView& str) {
+        char const* ptr = str.begin();
+        char const* end = str.end();
+        bool const  neg = ptr != end && *ptr == '-';
+        if (neg && !std::is_signed<val_t>::value)
+            return _fallback(str);
+        ptr += neg ? 1 : 0;
+
+        uint64_t acc     = 0;
+        size_t   ndigits = _scan_digits(ptr, end, acc);
+        if (ndigits == 0 || (ptr != end && _is_digit(*ptr)))
+            return _fallback(str);  // Not a number, or possibly too large for the accumulator
+
+        // Checked in the unsigned domain to not overflow on the most negative value
+        auto const max_abs = static_cast<uint64_t>(limits<val_t>::max()) + (neg ? 1U : 0U);
+        if (acc > max_abs)
+            throw std::out_of_range(fmt::format("Out of range parsing {} (as {})",
+                                                StringView(str.begin(), ptr).to_cpp_string(),
+                                                typeid(T).name()));
+
+        str       = StringView(ptr, end);
+        val_t val = neg ? static_cast<val_t>(0U - acc) : static_cast<val_t>(acc);
+        return checked_cast<T>(val);
+    }
+
+    static T _consume_real(StringView& str) {
+        // Powers of ten exactly representable as doubles
+        static constexpr double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                           1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                           1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        static constexpr uint64_t max_exact = 1ULL << 53U;
+
+        if (sizeof(val_t) > sizeof(double))
+            return _fallback(str);  // Would lose precision w.r.t. strtold
+
+        char const* ptr = str.begin();
+        char const* end = str.end();
+        bool const  neg = ptr != end && *ptr == '-';
+        ptr += neg ? 1 : 0;
+
+        uint64_t mantissa  = 0;
+        size_t   int_size  = _scan_digits(ptr, end, mantissa);
+        size_t   frac_size = 0;
+        if (ptr != end && *ptr == '.') {
+            ++ptr;
+            frac_size = _scan_digits(ptr, end, mantissa);
+        }
+
+        bool const exotic = ptr != end && (std::isalnum(*ptr) != 0 || *ptr == '.');
+        if (int_size + frac_size == 0 || exotic || mantissa > max_exact ||
+            int_size + frac_size >= 19)
+            return _fallback(str);
+
+        // Both operands are exact, so the division is correctly rounded
+        double val = static_cast<double>(mantissa) / pow10[frac_size];
+        str        = StringView(ptr, end);
+        return checked_cast<T>(static_cast<val_t>(neg ? -val : val));
+    }
+};
+
 // Reads a file line by line returning trimmed string views
 struct FileLineIterator {
     std::ifstream in;
@@ -136,6 +258,34 @@ struct FileLineIterator {
     }
 };
 
+// Reads a memory-mapped file line by line returning trimmed string views that point directly into
+// the mapping. No copy and no allocation is performed. NOTE: views are not null-terminated, use
+// fast_string_to to parse them.
+struct MappedLineIterator {
+    MappedFile  file;
+    char const* pos;
+
+    explicit MappedLineIterator(std::string const& path)
+        : file(path)
+        , pos(file.data()) {
+    }
+
+    StringView next() {
+        char const* end = file.data() + file.size();
+        if (pos == end)
+            return {end, end};
+
+        char const* line_end = static_cast<char const*>(
+            std::memchr(pos, '\n', checked_cast<size_t>(end - pos)));
+        if (line_end == nullptr)
+            line_end = end;
+
+        auto line = StringView(pos, line_end);
+        pos       = line_end == end ? end : line_end + 1;
+        return trim(line);
+    }
+};
+
 }  // namespace cft
 
 
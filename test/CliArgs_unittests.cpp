@@ -39,6 +39,51 @@ TEST_CASE("parse_cli_args parses command line arguments correctly") {
     CHECK_NOTHROW(print_arg_values(env));
 }
 
+TEST_CASE("parse_cli_args parses parsing options") {
+    char const* argv[] = {
+        "program_name", "-i", "input.txt", "-m", "--nthreads", "4", "-c", "input.cftb"};
+    int  argc = sizeof(argv) / sizeof(argv[0]);
+    auto env  = parse_cli_args(argc, argv);
+
+    CHECK(env.use_mmap);
+    CHECK(env.nthreads == 4);
+    CHECK(env.convert_path == "input.cftb");
+}
+
+TEST_CASE("parse_cli_args parses portfolio size") {
+    char const* argv[] = {"program_name", "-i", "input.txt", "--portfolio", "3", "-n", "6"};
+    int         argc   = sizeof(argv) / sizeof(argv[0]);
+    auto        env    = parse_cli_args(argc, argv);
+
+    CHECK(env.portfolio == 3);
+    CHECK(env.nthreads == 6);
+}
+
+TEST_CASE("parse_cli_args parses the enumeration limits") {
+    char const* argv[] = {"program_name", "-i", "input.txt", "--enum-vars", "12", "-y", "1000"};
+    int         argc   = sizeof(argv) / sizeof(argv[0]);
+    auto        env    = parse_cli_args(argc, argv);
+
+    CHECK(env.enum_vars == 12);
+    CHECK(env.enum_nodes == 1000);
+}
+
+TEST_CASE("parse_cli_args parses profile path") {
+    char const* argv[] = {"program_name", "-i", "input.txt", "--profile", "prof.csv"};
+    int         argc   = sizeof(argv) / sizeof(argv[0]);
+    auto        env    = parse_cli_args(argc, argv);
+
+    CHECK(env.profile_path == "prof.csv");
+    CHECK(env.checkpoint_path.empty());
+    CHECK(parse_cli_args(3, argv).profile_path.empty());
+}
+
+TEST_CASE("parse_cli_args parses checkpoint path") {
+    char const* argv[] = {"program_name", "-i", "input.txt", "-k", "state.cftk"};
+    int         argc   = sizeof(argv) / sizeof(argv[0]);
+    CHECK(parse_cli_args(argc, argv).checkpoint_path == "state.cftk");
+}
+
 TEST_CASE("parse_cli_args no args") {
     char const* argv[] = {"program_name"};
     int         argc   = sizeof(argv) / sizeof(argv[0]);
@@ -8,6 +8,7 @@
 #include <stdexcept>
 
 #include "core/Instance.hpp"
+#include "core/InstanceDelta.hpp"
 #include "core/cft.hpp"
 
 namespace cft {
@@ -30,7 +31,7 @@ namespace local { namespace {
         auto inst  = Instance();
         inst.cols  = std::move(cols);
         inst.costs = std::move(costs);
-        inst.rows.resize(nrows);
+        inst.rows.begs.assign(nrows + 1_R, 0);  // nrows empty rows
 
         return inst;
     }
@@ -48,11 +49,33 @@ TEST_CASE("Test fill_rows_from_cols") {
 TEST_CASE("Test fill_rows_from_cols fail") {
     auto inst = local::make_partial_inst();
     CHECK_NOTHROW(fill_rows_from_cols(inst.cols, rsize(inst.rows), inst.rows));
-    inst.rows.back().push_back(0_C);
+    inst.rows.idxs.back() = 0_C;  // last row is covered by column 3 only
     CHECK_THROWS_AS(col_and_rows_check(inst.cols, inst.rows), std::runtime_error);
 }
 #endif
 
+TEST_CASE("Test fill_rows_from_cols layout") {
+    auto inst = local::make_partial_inst();
+    fill_rows_from_cols(inst.cols, rsize(inst.rows), inst.rows);
+    REQUIRE(rsize(inst.rows) == 40_R);
+    CHECK(inst.rows.idxs.size() == inst.cols.idxs.size());
+    CHECK(inst.rows.begs.back() == inst.rows.idxs.size());
+
+    // Each row lists its columns in increasing order
+    auto row1 = inst.rows[1];
+    REQUIRE(row1.size() == 2);
+    CHECK(row1[0] == 0_C);
+    CHECK(row1[1] == 4_C);
+    auto row0 = inst.rows[0];
+    REQUIRE(row0.size() == 1);
+    CHECK(row0[0] == 3_C);
+
+    // Refilling reuses the same storage and gives the same result
+    auto old_rows = inst.rows;
+    fill_rows_from_cols(inst.cols, rsize(inst.rows), inst.rows);
+    CHECK(inst.rows == old_rows);
+}
+
 TEST_CASE("Test push_back_col_from") {
     auto inst1 = local::make_partial_inst();
     auto inst2 = local::make_partial_inst();
@@ -75,5 +98,62 @@ TEST_CASE("Test clear inst") {
     CHECK(inst.costs.empty());
 }
 
+TEST_CASE("Test apply_instance_delta matches a rebuilt instance") {
+    auto inst = local::make_partial_inst();
+    fill_rows_from_cols(inst.cols, rsize(inst.rows), inst.rows);
+
+    auto delta         = InstanceDelta();
+    delta.removed_cols = {4_C, 1_C};
+    delta.new_costs    = {CidxAndCost{2_C, 0.5_F}, CidxAndCost{6_C, 9.0_F}};
+    delta.added_cols.push_back({11_R, 12_R, 13_R});
+    delta.added_cols.push_back({14_R, 15_R, 16_R, 17_R, 18_R, 19_R, 20_R});
+    delta.added_costs = {3.0_F, 8.0_F};
+
+    auto old2new = std::vector<cidx_t>();
+    REQUIRE_NOTHROW(apply_instance_delta(delta, inst, old2new));
+    CHECK(old2new == std::vector<cidx_t>{0_C, removed_cidx, 1_C, 2_C, removed_cidx, 3_C, 4_C});
+
+    auto orig     = local::make_partial_inst();
+    auto expected = Instance();
+    for (cidx_t j : {0_C, 2_C, 3_C, 5_C, 6_C})
+        push_back_col_from(orig, j, expected);
+    expected.costs[1] = 0.5_F;
+    expected.costs[4] = 9.0_F;
+    for (cidx_t j = 0_C; j < csize(delta.added_costs); ++j) {
+        expected.cols.push_back(delta.added_cols[j]);
+        expected.costs.push_back(delta.added_costs[j]);
+    }
+    fill_rows_from_cols(expected.cols, 40_R, expected.rows);
+
+    CHECK(inst.cols == expected.cols);
+    CHECK(inst.rows == expected.rows);
+    CHECK(inst.costs == expected.costs);
+
+    auto sol = Solution();
+    sol.idxs = {0_C, 1_C, 2_C, 3_C};
+    remap_solution(inst, old2new, sol);
+    CHECK(sol.idxs == std::vector<cidx_t>{0_C, 1_C, 2_C});
+    CHECK(sol.cost == 1.0_F + 0.5_F + 4.0_F);
+}
+
+TEST_CASE("Test apply_instance_delta fail") {
+    auto inst = local::make_partial_inst();
+    fill_rows_from_cols(inst.cols, rsize(inst.rows), inst.rows);
+    auto old_inst = inst;
+    auto old2new  = std::vector<cidx_t>();
+
+    auto delta         = InstanceDelta();
+    delta.removed_cols = {7_C};  // Out of range
+    CHECK_THROWS_AS(apply_instance_delta(delta, inst, old2new), std::invalid_argument);
+
+    delta = InstanceDelta();
+    delta.added_cols.push_back({1_R, 2_R});  // Missing cost
+    CHECK_THROWS_AS(apply_instance_delta(delta, inst, old2new), std::invalid_argument);
+    CHECK(inst.cols == old_inst.cols);  // Invalid deltas leave inst untouched
+
+    delta              = InstanceDelta();
+    delta.removed_cols = {3_C};  // Row 0 is covered by column 3 only
+    CHECK_THROWS_AS(apply_instance_delta(delta, inst, old2new), std::invalid_argument);
+}
 
 }  // namespace cft
\ No newline at end of file
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <vector>
+
+#include "core/Instance.hpp"
+#include "core/cft.hpp"
+#include "subgradient/Pricer.hpp"
+#include "test_utils.hpp"
+#include "utils/SortedArray.hpp"
+#include "utils/Span.hpp"
+#include "utils/random.hpp"
+#include "utils/sort.hpp"
+
+namespace cft {
+namespace local { namespace {
+    // Small perturbations, so that successive cores share most of their columns
+    void perturb_mult(prng_t& rnd, std::vector<real_t>& lagr_mult) {
+        for (real_t& u : lagr_mult)
+            u *= rnd_real(rnd, 0.9_F, 1.1_F);
+    }
+
+    // The core must contain exactly the selected columns of inst, with coherent rows
+    void check_core(Instance const& inst, InstAndMap const& core) {
+        REQUIRE(csize(core.inst.cols) == csize(core.col_map));
+        REQUIRE(csize(core.inst.costs) == csize(core.col_map));
+        for (cidx_t k = 0_C; k < csize(core.col_map); ++k) {
+            auto core_col = core.inst.cols[k];
+            auto orig_col = inst.cols[core.col_map[k]];
+            CHECK(std::vector<ridx_t>(core_col.begin(), core_col.end()) ==
+                  std::vector<ridx_t>(orig_col.begin(), orig_col.end()));
+            CHECK(core.inst.costs[k] == inst.costs[core.col_map[k]]);
+        }
+        auto rows = SparseBinMat<cidx_t>();
+        fill_rows_from_cols(core.inst.cols, rsize(inst.rows), rows);
+        CHECK(core.inst.rows == rows);
+    }
+}  // namespace
+}  // namespace local
+
+TEST_CASE("Incremental pricing matches a full rebuild") {
+    auto env = Environment();
+    auto rnd = prng_t{42};
+    for (uint64_t n = 0; n < 20; ++n) {
+        auto inst = make_easy_inst(n, 1000_C);
+
+        auto incr_pricer = Pricer();
+        auto incr_core   = InstAndMap();
+        auto lagr_mult   = std::vector<real_t>(rsize(inst.rows), 0.5_F);
+        for (int p = 0; p < 5; ++p) {
+            local::perturb_mult(rnd, lagr_mult);
+            real_t incr_lb = incr_pricer(env, inst, lagr_mult, incr_core);
+
+            auto   full_core = InstAndMap();
+            real_t full_lb   = Pricer()(env, inst, lagr_mult, full_core);
+
+            CHECK(incr_lb == full_lb);
+            local::check_core(inst, incr_core);
+
+            // Same selected columns, possibly in a different order
+            auto incr_map = incr_core.col_map;
+            auto full_map = full_core.col_map;
+            cft::sort(incr_map);
+            cft::sort(full_map);
+            CHECK(incr_map == full_map);
+        }
+    }
+}
+
+TEST_CASE("Threshold filtered insertion keeps the same cheapest columns") {
+    auto rnd           = prng_t{11};
+    auto reduced_costs = std::vector<real_t>(1000);
+    for (real_t& rc : reduced_costs)
+        rc = as_real(roll_dice(rnd, -5, 5));  // Plenty of ties
+
+    auto row = std::vector<cidx_t>();
+    for (int n = 0; n < 200; ++n) {
+        row.resize(roll_dice(rnd, 0_C, 100_C));
+        for (cidx_t& j : row)
+            j = roll_dice(rnd, 0_C, csize(reduced_costs) - 1_C);
+
+        auto key      = [&](cidx_t j) { return reduced_costs[j]; };
+        auto expected = make_custom_key_sorted_array<cidx_t, 5>(key);
+        for (cidx_t j : row)
+            expected.try_insert(j);
+        auto                       heap = make_custom_key_sorted_array<cidx_t, 5>(key);
+        std::vector<cidx_t> const& crow = row;
+        local::insert_cheapest(make_span(crow.data(), crow.size()), reduced_costs.data(), heap);
+
+        CHECK(std::vector<cidx_t>(heap.begin(), heap.end()) ==
+              std::vector<cidx_t>(expected.begin(), expected.end()));
+    }
+}
+
+TEST_CASE("Parallel pricing does not depend on the number of threads") {
+    auto rnd       = prng_t{7};
+    auto inst      = make_easy_inst(0, 100000_C);  // Large enough to be split among threads
+    auto lagr_mult = std::vector<real_t>(rsize(inst.rows), 0.5_F);
+    local::perturb_mult(rnd, lagr_mult);
+
+    auto   env      = Environment();
+    auto   seq_core = InstAndMap();
+    real_t seq_lb   = Pricer()(env, inst, lagr_mult, seq_core);
+    for (uint64_t nthreads : {2U, 3U, 8U}) {
+        env.nthreads  = nthreads;
+        auto   core   = InstAndMap();
+        real_t par_lb = Pricer()(env, inst, lagr_mult, core);
+        CHECK(par_lb == seq_lb);
+        CHECK(core.col_map == seq_core.col_map);
+        CHECK(core.inst.rows == seq_core.inst.rows);
+    }
+}
+
+}  // namespace cft
@@ -6,10 +6,15 @@
 
 #include <doctest/doctest.h>
 
+#include <chrono>
+#include <memory>
+#include <thread>
+
 #define CFT_CIDX_TYPE int
 #define CFT_RIDX_TYPE int
 #define CFT_REAL_TYPE float
 
+#include "algorithms/Incremental.hpp"
 #include "algorithms/Refinement.hpp"
 #include "algorithms/ThreePhase.hpp"
 #include "core/Instance.hpp"
@@ -53,6 +58,72 @@ TEST_CASE("Invoke whole algorithm") {
     }());
 }
 
+TEST_CASE("Stream improving solutions") {
+    // Setup
+    auto env       = cft::Environment();
+    env.time_limit = 10.0;
+    env.verbose    = 1;
+
+    auto inst = cft::Instance();
+    REQUIRE_NOTHROW(inst = cft::make_easy_inst(10, 1000));
+
+    // Test Readme example
+    REQUIRE_NOTHROW([&] {
+        env.on_incumbent = [](cft::Solution const& sol, cft::real_t lb, double time) {
+            fmt::print("New solution {} (LB {}) at {:.2f}s\n", sol.cost, lb, time);
+        };
+        cft::run(env, inst);
+    }());
+}
+
+TEST_CASE("Stop a run from another thread") {
+    // Setup
+    auto env       = cft::Environment();
+    env.time_limit = 10.0;
+    env.verbose    = 1;
+
+    auto inst = cft::Instance();
+    REQUIRE_NOTHROW(inst = cft::make_easy_inst(10, 1000));
+
+    // Test Readme example
+    REQUIRE_NOTHROW([&] {
+        env.stop_token = std::make_shared<cft::StopToken>();
+        env.stop_token->set_timeout(5.0);  // Stop within 5 seconds from now...
+        auto stopper = std::thread([&] {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            env.stop_token->request_stop();  // ...or as soon as another thread asks to
+        });
+        auto res = cft::run(env, inst);
+        stopper.join();
+    }());
+}
+
+TEST_CASE("Incremental re-solve") {
+    // Setup
+    auto env       = cft::Environment();
+    env.time_limit = 10.0;
+    env.verbose    = 1;
+
+    auto inst = cft::Instance();
+    REQUIRE_NOTHROW(inst = cft::make_easy_inst(10, 1000));
+
+    // Test Readme example
+    REQUIRE_NOTHROW([&] {
+        auto res = cft::run(env, inst);
+
+        auto delta         = cft::InstanceDelta();
+        delta.removed_cols = {3, 7};         // Columns 3 and 7 are gone
+        delta.new_costs    = {{0, 2.5}};     // Column 0 now costs 2.5
+        delta.added_cols.push_back({1, 4});  // One new column, covering rows 1 and 4...
+        delta.added_costs  = {1.0};          // ... with cost 1.0
+
+        env.time_limit = 1.0;
+        env.timer.restart();
+        res = cft::resolve(env, inst, delta, res);  // inst is updated in place
+        fmt::print("Re-solved solution cost: {}\n", res.sol.cost);
+    }());
+}
+
 TEST_CASE("Invoke 3-phase algorithm") {
     // Setup
     auto env       = cft::Environment();
@@ -5,10 +5,19 @@
 #define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
 #include <doctest/doctest.h>
 
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "algorithms/Incremental.hpp"
 #include "algorithms/Refinement.hpp"
 #include "core/Instance.hpp"
+#include "core/SharedIncumbent.hpp"
 #include "core/cft.hpp"
+#include "fixing/FixingData.hpp"
 #include "test_utils.hpp"
+#include "utils/Chrono.hpp"
+#include "utils/random.hpp"
 
 namespace cft {
 
@@ -28,12 +37,303 @@ TEST_CASE("Whole algorithm run test") {
         REQUIRE_NOTHROW(res = run(env, inst, init_sol));
         CHECK(res.sol.cost <= 1000.0_F);                      // Trivial bad solution has 1000 cost
         CHECK(res.sol.cost >= as_real(res.sol.idxs.size()));  // Min col cost is 1.0
-        if (abs(res.sol.cost - 1000.0_F) < 1e-6_F)
+        if (abs(res.sol.cost - 1000.0_F) < 1e-6_F) {
             CHECK(res.sol.idxs == init_sol.idxs);
+            CHECK(res.sol_time == 0.0);
+        }
+        CHECK(res.sol_time <= env.timer.elapsed<sec>());
         CFT_IF_DEBUG(CHECK_NOTHROW(check_inst_solution(inst, res.sol)));
     }
 }
 
+TEST_CASE("Portfolio run test") {
+    auto env       = Environment();
+    env.time_limit = 10.0;
+    env.heur_iters = 100;
+    env.verbose    = 0;
+    env.portfolio  = 3;
+
+    for (int n = 0; n < 20; ++n) {
+        auto inst = Instance();
+        auto res  = CftResult();
+        REQUIRE_NOTHROW(inst = make_easy_inst(n, 1000_C));
+        REQUIRE_NOTHROW(res = run(env, inst));
+        CHECK(!res.sol.idxs.empty());
+        CHECK(res.sol.cost >= res.dual.lb - env.epsilon);
+        CHECK(res.sol_time > 0.0);
+        CHECK(res.sol_time <= env.timer.elapsed<sec>());
+        CFT_IF_DEBUG(CHECK_NOTHROW(check_inst_solution(inst, res.sol)));
+    }
+}
+
+TEST_CASE("Run collects the per-component profile") {
+    auto env       = Environment();
+    env.time_limit = 10.0;
+    env.heur_iters = 100;
+    env.verbose    = 0;
+    auto inst      = make_easy_inst(0, 1000_C);
+
+    auto res       = CftResult();
+    for (uint64_t portfolio : {1U, 2U}) {
+        env.portfolio = portfolio;
+        REQUIRE_NOTHROW(res = run(env, inst));
+        Profile const& prof = res.profile;
+        CHECK(prof.subgradient.calls > 0);
+        CHECK(prof.subgradient.work > 0);
+        CHECK(prof.heuristic.calls > 0);
+        CHECK(prof.greedy.calls > 0);
+        CHECK(prof.greedy.work > 0);
+        CHECK(prof.redundancy.calls <= prof.greedy.calls);
+        CHECK(prof.pricing.calls > 0);
+        CHECK(prof.col_fixing.calls > 0);
+        CHECK(prof.refinement_fixing.calls > 0);
+        CHECK(env.profile.subgradient.calls == 0);  // Runs work on their own copy of env
+    }
+
+    auto json = profile_to_json(res.profile);
+    auto csv  = profile_to_csv(res.profile);
+    for (char const* name : {"subgradient", "heuristic", "greedy", "redundancy", "col_fixing",
+                             "pricing", "refinement_fixing"}) {
+        CHECK(json.find(fmt::format("\"{}\": {{", name)) != std::string::npos);
+        CHECK(csv.find(fmt::format("\n{},", name)) != std::string::npos);
+    }
+}
+
+TEST_CASE("Concurrent runs can share an Environment") {
+    auto env       = Environment();
+    env.time_limit = 10.0;
+    env.heur_iters = 100;
+    env.verbose    = 0;
+    auto inst      = make_easy_inst(0, 1000_C);
+
+    auto res1  = CftResult();
+    auto other = std::thread([&] { res1 = run(env, inst); });
+    auto res2  = run(env, inst);
+    other.join();
+    CHECK(res1.sol.cost == res2.sol.cost);  // Same seed, same inputs
+    CHECK(res1.profile.subgradient.work == res2.profile.subgradient.work);
+}
+
+TEST_CASE("Run warm started from a previous dual state") {
+    auto env       = Environment();
+    env.time_limit = 10.0;
+    env.heur_iters = 100;
+    env.verbose    = 0;
+
+    for (int n = 0; n < 10; ++n) {
+        auto inst = make_easy_inst(n, 1000_C);
+        env.timer.restart();  // The time limit applies to each run, even in slow debug builds
+        auto cold = run(env, inst);
+        REQUIRE(rsize(cold.dual.mults) == rsize(inst.rows));
+        CHECK(!cold.dual.core_cols.empty());
+        CHECK(cold.dual.step_size > 0.0_F);
+
+        env.timer.restart();
+        auto warm = run(env, inst, cold.sol, cold.dual);
+        CHECK(warm.sol.cost <= cold.sol.cost);
+        CHECK(warm.dual.lb >= 0.0_F);
+        CFT_IF_DEBUG(CHECK_NOTHROW(check_inst_solution(inst, warm.sol)));
+
+        // A dual state of another instance is ignored
+        auto wrong_dual = cold.dual;
+        wrong_dual.mults.pop_back();
+        CHECK_NOTHROW(run(env, inst, Solution(), wrong_dual));
+    }
+}
+
+TEST_CASE("Run streams improving solutions to the callback") {
+    auto env       = Environment();
+    env.time_limit = 10.0;
+    env.heur_iters = 100;
+    env.verbose    = 0;
+
+    for (uint64_t portfolio : {1U, 3U}) {
+        env.portfolio = portfolio;
+        for (int n = 0; n < 5; ++n) {
+            auto inst         = make_easy_inst(n, 1000_C);
+            auto sols         = std::vector<Solution>();
+            auto lbs          = std::vector<real_t>();
+            auto times        = std::vector<double>();
+            auto caller       = std::this_thread::get_id();
+            bool other_thread = true;
+
+            env.on_incumbent = [&](Solution const& sol, real_t lb, double time) {
+                other_thread = other_thread && std::this_thread::get_id() != caller;
+                sols.push_back(sol);
+                lbs.push_back(lb);
+                times.push_back(time);
+            };
+            auto res = run(env, inst);
+            CHECK(env.notifier == nullptr);
+
+            REQUIRE(!sols.empty());
+            CHECK(other_thread);
+            CHECK(sols.back().cost == res.sol.cost);
+            for (size_t k = 1; k < sols.size(); ++k) {
+                CHECK(sols[k].cost < sols[k - 1].cost);
+                CHECK(lbs[k] >= lbs[k - 1]);
+                CHECK(times[k] >= times[k - 1]);
+            }
+            for (size_t k = 0; k < sols.size(); ++k)
+                CHECK(lbs[k] <= sols[k].cost);
+            CHECK(times.back() <= env.timer.elapsed<sec>());
+            for (Solution const& sol : sols)
+                CFT_IF_DEBUG(CHECK_NOTHROW(check_inst_solution(inst, sol)));
+        }
+    }
+}
+
+TEST_CASE("A slow callback does not lose the final solution") {
+    auto env       = Environment();
+    env.time_limit = 10.0;
+    env.heur_iters = 100;
+    env.verbose    = 0;
+    auto inst      = make_easy_inst(1, 1000_C);
+
+    auto last_cost   = limits<real_t>::max();
+    env.on_incumbent = [&](Solution const& sol, real_t, double) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        last_cost = sol.cost;
+    };
+    auto res = run(env, inst);
+    CHECK(last_cost == res.sol.cost);
+
+    env.on_incumbent = [](Solution const&, real_t, double) {
+        throw std::runtime_error("Callback failure");
+    };
+    CHECK_THROWS_AS(run(env, inst), std::runtime_error);
+    CHECK(env.notifier == nullptr);
+}
+
+TEST_CASE("Run stops soon after a stop request or a deadline") {
+    auto env       = Environment();
+    env.heur_iters = 100;
+    env.verbose    = 0;
+    auto inst      = make_easy_inst(0, 100000_C);  // Takes about a second without stopping
+
+    env.stop_token = std::make_shared<StopToken>();
+    for (uint64_t portfolio : {1U, 2U}) {
+        env.portfolio = portfolio;
+
+        // Stop requested by another thread
+        env.stop_token->reset();
+        env.timer.restart();
+        auto stopper = std::thread([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            env.stop_token->request_stop();
+        });
+        auto res = run(env, inst);
+        stopper.join();
+        CHECK(env.timer.elapsed<sec>() < 0.5);
+        CHECK(!res.sol.idxs.empty());
+        CHECK(res.dual.lb >= 0.0_F);  // A real bound, even if stopped before the first pricing
+        CHECK(res.dual.lb <= res.sol.cost);
+        CFT_IF_DEBUG(CHECK_NOTHROW(check_inst_solution(inst, res.sol)));
+
+        // Deadline
+        env.stop_token->reset();
+        env.stop_token->set_timeout(0.02);
+        env.timer.restart();
+        res = run(env, inst);
+        CHECK(env.timer.elapsed<sec>() < 0.5);
+        CHECK(res.dual.lb >= 0.0_F);
+        CHECK(res.dual.lb <= res.sol.cost);
+        CFT_IF_DEBUG(CHECK_NOTHROW(check_inst_solution(inst, res.sol)));
+    }
+
+    // Already stopped: the initial greedy solution is returned
+    env.portfolio = 1;
+    env.stop_token->reset();
+    env.stop_token->request_stop();
+    auto res = run(env, inst);
+    CHECK(!res.sol.idxs.empty());
+    CHECK(res.dual.lb >= 0.0_F);
+    CHECK(res.dual.lb <= res.sol.cost);
+    CFT_IF_DEBUG(CHECK_NOTHROW(check_inst_solution(inst, res.sol)));
+}
+
+TEST_CASE("Incremental re-solve after a few column changes") {
+    auto env       = Environment();
+    env.time_limit = 10.0;
+    env.heur_iters = 100;
+    env.verbose    = 0;
+
+    for (int n = 0; n < 10; ++n) {
+        auto inst = make_easy_inst(n, 1000_C);
+        auto prev = run(env, inst);
+
+        // Remove part of the solution (columns 0-9 alone cover all rows), re-cost and add some
+        auto delta = InstanceDelta();
+        for (cidx_t j : prev.sol.idxs)
+            if (j >= 10_C && delta.removed_cols.size() < 3)
+                delta.removed_cols.push_back(j);
+        for (cidx_t j = 0_C; j < 5_C; ++j)
+            delta.new_costs.push_back({j, 1.0_F});
+        delta.added_cols.push_back({0_R, 50_R, 99_R});
+        delta.added_costs.push_back(2.0_F);
+        cidx_t const new_ncols = csize(inst.cols) - csize(delta.removed_cols) + 1_C;
+
+        auto res = CftResult();
+        REQUIRE_NOTHROW(res = resolve(env, inst, delta, prev));
+        CHECK(csize(inst.cols) == new_ncols);
+        CHECK(res.sol.cost >= res.dual.lb - env.epsilon);
+        CFT_IF_DEBUG(CHECK_NOTHROW(check_inst_solution(inst, res.sol)));
+    }
+}
+
+TEST_CASE("SharedIncumbent keeps the best solution") {
+    auto sol = Solution();
+    sol.idxs = std::vector<cidx_t>{0_C, 1_C};
+    sol.cost = 10.0_F;
+    SharedIncumbent incb(sol);
+    CHECK(incb.cost() == 10.0_F);
+
+    sol.cost = 12.0_F;
+    CHECK_FALSE(incb.try_update(sol));
+    sol.idxs = std::vector<cidx_t>{2_C};
+    sol.cost = 5.0_F;
+    CHECK(incb.try_update(sol));
+    CHECK(incb.cost() == 5.0_F);
+    CHECK(incb.solution().idxs == std::vector<cidx_t>{2_C});
+
+    CHECK_FALSE(incb.stop_requested());
+    incb.request_stop();
+    CHECK(incb.stop_requested());
+}
+
+TEST_CASE("Fixing into a separate instance matches inplace fixing") {
+    auto fixed_inst = Instance();  // Reused across iterations, as in Refinement
+    for (uint64_t n = 0; n < 20; ++n) {
+        auto inst        = make_easy_inst(n, 1000_C);
+        auto rnd         = prng_t{n};
+        auto cols_to_fix = std::vector<cidx_t>();
+        for (cidx_t j = 0_C; j < csize(inst.cols); ++j)
+            if (coin_flip(rnd, 0.01))
+                cols_to_fix.push_back(j);
+        if (cols_to_fix.empty())
+            cols_to_fix.push_back(0_C);
+
+        auto inplace_inst   = inst;
+        auto inplace_fixing = FixingData();
+        auto inplace_maps   = IdxsMaps();
+        make_identity_fixing_data(csize(inst.cols), rsize(inst.rows), inplace_fixing);
+        fix_columns_and_compute_maps(cols_to_fix, inplace_inst, inplace_fixing, inplace_maps);
+
+        auto fixing = FixingData();
+        auto maps   = IdxsMaps();
+        make_identity_fixing_data(csize(inst.cols), rsize(inst.rows), fixing);
+        fix_columns_and_compute_maps(cols_to_fix, inst, fixed_inst, fixing, maps);
+
+        CHECK(fixed_inst.cols == inplace_inst.cols);
+        CHECK(fixed_inst.rows == inplace_inst.rows);
+        CHECK(fixed_inst.costs == inplace_inst.costs);
+        CHECK(fixing.curr2orig.col_map == inplace_fixing.curr2orig.col_map);
+        CHECK(fixing.curr2orig.row_map == inplace_fixing.curr2orig.row_map);
+        CHECK(fixing.fixed_cols == inplace_fixing.fixed_cols);
+        CHECK(fixing.fixed_cost == inplace_fixing.fixed_cost);
+    }
+}
+
 TEST_CASE("from_fixed_to_unfixed_sol test") {
     // Test case 1
     auto sol1                 = Solution();
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <thread>
+#include <vector>
+
+#include "utils/SpscQueue.hpp"
+
+namespace cft {
+
+TEST_CASE("SpscQueue push and pop") {
+    SpscQueue<int> queue(3);  // Neither copyable nor movable
+    int            val = 0;
+    CHECK(queue.capacity() == 3);
+    CHECK_FALSE(queue.try_pop(val));
+
+    CHECK(queue.try_push(1));
+    CHECK(queue.try_push(2));
+    CHECK(queue.try_push(3));
+    CHECK_FALSE(queue.try_push(4));  // Full
+
+    CHECK(queue.try_pop(val));
+    CHECK(val == 1);
+    CHECK(queue.try_push(4));  // Wraps around
+    for (int expected : {2, 3, 4}) {
+        CHECK(queue.try_pop(val));
+        CHECK(val == expected);
+    }
+    CHECK_FALSE(queue.try_pop(val));
+    CHECK(val == 4);
+}
+
+TEST_CASE("SpscQueue recycles the slot buffers") {
+    SpscQueue<std::vector<int>> queue(1);
+    auto                        out = std::vector<int>();
+    out.reserve(100);
+    int const* buffer = out.data();
+
+    REQUIRE(queue.try_push(std::vector<int>{1, 2, 3}));
+    REQUIRE(queue.try_pop(out));  // The reserved buffer goes into the slot...
+    CHECK(out == std::vector<int>{1, 2, 3});
+    REQUIRE(queue.try_push(std::vector<int>(50, 7)));  // ...and is reused by this push
+    REQUIRE(queue.try_pop(out));
+    CHECK(out.data() == buffer);
+}
+
+TEST_CASE("SpscQueue between two threads") {
+    int const      n = 100000;
+    SpscQueue<int> queue(16);
+
+    auto consumed = std::vector<int>();
+    auto consumer = std::thread([&] {
+        int val = 0;
+        while (consumed.size() < static_cast<size_t>(n))
+            if (queue.try_pop(val))
+                consumed.push_back(val);
+    });
+    for (int i = 0; i < n; ++i)
+        while (!queue.try_push(i)) {
+        }
+    consumer.join();
+
+    auto expected = std::vector<int>(n);
+    for (int i = 0; i < n; ++i)
+        expected[i] = i;
+    CHECK(consumed == expected);  // All delivered, in order
+}
+
+}  // namespace cft
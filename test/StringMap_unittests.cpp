@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <string>
+
+#include "utils/StringMap.hpp"
+
+namespace cft {
+
+TEST_CASE("StringMap: should find inserted keys") {
+    auto map = StringMap<int>();
+    CHECK(map.find("missing") == nullptr);
+    CHECK(map.insert("r_000001", 1));
+    CHECK(map.insert("r_000002", 2));
+    CHECK(map.size() == 2);
+
+    auto key = std::string("  r_000002  ");
+    REQUIRE(map.find(StringView(key).get_substr(2, 10)) != nullptr);
+    CHECK(*map.find(StringView(key).get_substr(2, 10)) == 2);
+    CHECK(*map.find("r_000001") == 1);
+    CHECK(map.find("r_00000") == nullptr);
+}
+
+TEST_CASE("StringMap: should not overwrite existing keys") {
+    auto map = StringMap<int>();
+    CHECK(map.insert("a", 1));
+    CHECK_FALSE(map.insert("a", 2));
+    CHECK(*map.find("a") == 1);
+    CHECK(map.size() == 1);
+}
+
+TEST_CASE("StringMap: should keep all keys while growing") {
+    auto map = StringMap<int>();
+    for (int n = 0; n < 10000; ++n)
+        CHECK(map.insert(std::to_string(n), n));
+    CHECK(map.size() == 10000);
+    for (int n = 0; n < 10000; ++n) {
+        auto const* val = map.find(std::to_string(n));
+        REQUIRE(val != nullptr);
+        CHECK(*val == n);
+    }
+    CHECK(map.insert("", -1));
+    CHECK(*map.find("") == -1);
+}
+
+}  // namespace cft
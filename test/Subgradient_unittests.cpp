@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <vector>
+
+#include "core/Instance.hpp"
+#include "core/cft.hpp"
+#include "core/utils.hpp"
+#include "greedy/Greedy.hpp"
+#include "subgradient/Pricer.hpp"
+#include "subgradient/Subgradient.hpp"
+#include "subgradient/utils.hpp"
+#include "test_utils.hpp"
+#include "utils/CoverCounters.hpp"
+#include "utils/random.hpp"
+
+namespace cft {
+
+TEST_CASE("Batched heuristic follows the sequential trajectory") {
+    auto env       = Environment();
+    env.verbose    = 0;
+    env.heur_iters = 100;
+
+    auto rnd = prng_t{3};
+    for (uint64_t n = 0; n < 20; ++n) {
+        auto inst      = make_easy_inst(n, 1000_C);
+        auto init_mult = std::vector<real_t>(rsize(inst.rows));
+        for (real_t& u : init_mult)
+            u = rnd_real(rnd, 0.0_F, 0.5_F);
+
+        auto seq_sol  = Solution();
+        seq_sol.idxs  = std::vector<cidx_t>{0_C, 1_C, 2_C, 3_C, 4_C, 5_C, 6_C, 7_C, 8_C, 9_C};
+        seq_sol.cost  = 1000.0_F;
+        auto seq_mult = init_mult;
+        auto greedy   = Greedy();
+        env.nthreads  = 1;
+        Subgradient().heuristic(env, inst, 0.1_F, greedy, seq_sol, seq_mult);
+
+        for (uint64_t nthreads : {2U, 5U}) {
+            auto sol     = Solution();
+            sol.idxs     = std::vector<cidx_t>{0_C, 1_C, 2_C, 3_C, 4_C, 5_C, 6_C, 7_C, 8_C, 9_C};
+            sol.cost     = 1000.0_F;
+            auto mult    = init_mult;
+            env.nthreads = nthreads;
+            Subgradient().heuristic(env, inst, 0.1_F, greedy, sol, mult);
+            CHECK(sol.cost == seq_sol.cost);
+            CHECK(sol.idxs == seq_sol.idxs);
+            CHECK(mult == seq_mult);
+        }
+    }
+}
+
+TEST_CASE("Fused multiplier update matches the row by row update") {
+    auto rnd = prng_t{5};
+    for (size_t nrows : {0U, 1U, 7U, 8U, 9U, 100U, 1003U}) {
+        auto coverage = CoverCounters(nrows);
+        auto mult     = std::vector<real_t>(nrows);
+        for (size_t i = 0; i < nrows; ++i) {
+            coverage.cov_counters[i] = roll_dice(rnd, 0U, 4U);
+            mult[i]                  = rnd_real(rnd, 0.0_F, 2.0_F);
+        }
+        if (nrows > 0) {  // Clamped at 0
+            coverage.cov_counters[0] = 3U;
+            mult[0]                  = 0.05_F;
+        }
+
+        int64_t exp_norm = 0;
+        auto    exp_mult = mult;
+        for (size_t i = 0; i < nrows; ++i) {
+            int64_t violation = 1 - checked_cast<int64_t>(coverage[i]);
+            exp_norm += violation * violation;
+            if (violation != 0)
+                exp_mult[i] = clamp(mult[i] + 0.1_F * as_real(violation), 0.0_F, 1e6_F);
+        }
+        CHECK(local::subgrad_sqr_norm(coverage) == as_real(exp_norm));
+
+        auto   delta    = std::vector<real_t>();
+        auto   old_mult = mult;
+        real_t sum      = local::update_lagr_mult(coverage, 0.1_F, mult, delta);
+        CHECK(mult == exp_mult);
+        CHECK(sum == local::sum_lagr_mult(mult));
+        REQUIRE(delta.size() == nrows);
+        real_t exp_sum = 0.0_F;
+        for (size_t i = 0; i < nrows; ++i) {
+            CHECK(delta[i] == mult[i] - old_mult[i]);
+            exp_sum += mult[i];
+        }
+        CHECK(abs(sum - exp_sum) <= 1e-3_F);
+    }
+}
+
+TEST_CASE("Live reduced costs match a fresh computation between refreshes") {
+    auto rnd = prng_t{7};
+    for (uint64_t n = 0; n < 10; ++n) {
+        auto inst = make_easy_inst(n, 1000_C);
+        auto mult = std::vector<real_t>(rsize(inst.rows));
+        for (real_t& u : mult)
+            u = rnd_real(rnd, 0.0_F, 0.5_F);
+
+        auto live_costs  = std::vector<real_t>();
+        auto fresh_costs = std::vector<real_t>();
+        auto delta       = std::vector<real_t>();
+        auto coverage    = CoverCounters(rsize(inst.rows));
+        compute_reduced_costs(inst, mult, live_costs);
+
+        // As many updates as the default refresh period, each with its own coverage and step
+        for (uint64_t iter = 1; iter < Environment().red_costs_period; ++iter) {
+            coverage.reset(rsize(inst.rows));
+            for (cidx_t j = 0_C; j < csize(inst.cols); ++j)
+                if (live_costs[j] < 0.0_F || coin_flip(rnd, 0.01))
+                    coverage.cover(inst.cols[j]);
+            real_t step_factor = rnd_real(rnd, 0.001_F, 0.1_F);
+            local::update_lagr_mult(coverage, step_factor, mult, delta);
+            local::apply_mult_delta(inst, delta, live_costs);
+
+            compute_reduced_costs(inst, mult, fresh_costs);
+            real_t max_err = 0.0_F;
+            for (cidx_t j = 0_C; j < csize(inst.cols); ++j)
+                max_err = max(max_err,
+                              abs(live_costs[j] - fresh_costs[j]) / (1.0_F + abs(fresh_costs[j])));
+            CHECK(max_err <= 1e-4_F);
+        }
+    }
+}
+
+TEST_CASE("Subgradient runs with and without live reduced costs") {
+    auto env    = Environment();
+    env.verbose = 0;
+
+    for (uint64_t n = 0; n < 5; ++n) {
+        auto   inst   = make_easy_inst(n, 1000_C);
+        auto   greedy = Greedy();
+        auto   sol    = std::vector<cidx_t>();
+        real_t ub     = greedy(inst, std::vector<real_t>(rsize(inst.rows), 0.0_F), inst.costs, sol);
+
+        // Rounding differs, so the trajectories do too: both must just give valid bounds
+        for (uint64_t period : {1U, 32U}) {
+            env.red_costs_period = period;
+            auto   mult          = std::vector<real_t>(rsize(inst.rows), 0.0_F);
+            auto   price         = Pricer();
+            auto   core          = InstAndMap();
+            real_t step_size     = 0.1_F;
+            price(env, inst, mult, core);
+            real_t lb = Subgradient()(env, inst, ub, price, core, step_size, mult);
+            CHECK(lb > 0.0_F);
+            CHECK(lb <= ub);
+        }
+    }
+}
+
+}  // namespace cft
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// The debug consistency checks work on temporary copies, so this test always builds the release
+// code: the allocation check must run in every test build, Debug included.
+#ifndef NDEBUG
+#define NDEBUG
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "algorithms/ThreePhase.hpp"
+#include "core/Instance.hpp"
+#include "core/cft.hpp"
+#include "test_utils.hpp"
+
+// Allocation-counting hook: every heap allocation of this test executable goes through here.
+namespace {
+std::atomic<uint64_t> heap_allocs{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+    ++heap_allocs;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+// Also replaced, or its memory would come from the sanitizer allocator and be freed by free()
+void* operator new(std::size_t size, std::nothrow_t const& /*tag*/) noexcept {
+    ++heap_allocs;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::nothrow_t const& /*tag*/) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+    std::free(ptr);
+}
+
+namespace cft {
+
+// All the components of the three-phase keep their buffers as caches, so once they have grown to
+// the instance size, a whole run must only allocate the returned result (solution, multipliers and
+// core columns).
+TEST_CASE("Three-phase allocates only its result once warmed up") {
+    auto env       = Environment();
+    env.verbose    = 0;
+    env.heur_iters = 50;
+
+    for (uint64_t n = 0; n < 10; ++n) {
+        auto orig_inst   = make_easy_inst(n, 1000_C);
+        auto three_phase = ThreePhase();
+        auto inst        = Instance();
+
+        // Same seed and same instance: the second run follows the same path as the first
+        for (int run = 0; run < 2; ++run) {
+            inst    = orig_inst;
+            env.rnd = prng_t(n);
+
+            uint64_t allocs_before = heap_allocs.load();
+            auto     res           = three_phase(env, inst);
+            uint64_t allocs        = heap_allocs.load() - allocs_before;
+
+            CHECK(!res.sol.idxs.empty());
+            if (run == 1)
+                CHECK(allocs <= 3);  // CftResult copy of best_sol and nofix_dual (2 vectors)
+        }
+    }
+}
+
+}  // namespace cft
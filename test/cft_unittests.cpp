@@ -6,6 +6,8 @@
 
 #include <doctest/doctest.h>
 
+#include <cmath>
+
 #include "core/cft.hpp"
 
 namespace cft {
@@ -23,17 +25,50 @@ TEST_CASE("Test Solution struct") {
 }
 
 TEST_CASE("Test DualState struct") {
-    auto d = DualState{{}, 0.0_F};
+    auto d = DualState{{}, 0.0_F, {}, 0.1_F};
     CHECK(d.mults.empty());
     CHECK(d.lb == 0.0_F);
+    CHECK(d.core_cols.empty());
+    CHECK(d.step_size == 0.1_F);
 }
 
 TEST_CASE("Test CftResult struct") {
-    auto r = CftResult{{{}, 1.2_F}, {{}, 2.3_F}};
+    auto r = CftResult{{{}, 1.2_F}, {{}, 2.3_F, {}, 0.1_F}, 3.4, {}};
     CHECK(r.sol.idxs.empty());
     CHECK(r.sol.cost == 1.2_F);
     CHECK(r.dual.mults.empty());
     CHECK(r.dual.lb == 2.3_F);
+    CHECK(r.sol_time == 3.4);
+}
+
+TEST_CASE("Test StopToken and stop_requested") {
+    auto env = Environment();
+    CHECK_FALSE(stop_requested(env));
+
+    env.stop_token = std::make_shared<StopToken>();
+    CHECK_FALSE(stop_requested(env));
+    env.stop_token->request_stop();
+    CHECK(stop_requested(env));
+
+    env.stop_token->reset();
+    env.stop_token->set_timeout(3600.0);
+    CHECK_FALSE(stop_requested(env));
+    env.stop_token->set_timeout(0.0);
+    CHECK(stop_requested(env));
+    env.stop_token->set_timeout(-limits<double>::inf());
+    CHECK(stop_requested(env));
+
+    // Timeouts out of the clock range never expire
+    env.stop_token->set_timeout(limits<double>::inf());
+    CHECK_FALSE(stop_requested(env));
+    env.stop_token->set_timeout(1e300);
+    CHECK_FALSE(stop_requested(env));
+    env.stop_token->set_timeout(std::nan(""));
+    CHECK_FALSE(stop_requested(env));
+
+    env.stop_token->reset();
+    env.time_limit = 0.0;
+    CHECK(stop_requested(env));
 }
 
 TEST_CASE("Test as_cidx function") {
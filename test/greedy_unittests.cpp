@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <vector>
+
+#include "core/Instance.hpp"
+#include "core/cft.hpp"
+#include "core/utils.hpp"
+#include "greedy/Greedy.hpp"
+#include "greedy/scores.hpp"
+#include "test_utils.hpp"
+#include "utils/CoverCounters.hpp"
+#include "utils/random.hpp"
+
+namespace cft {
+
+TEST_CASE("Lazy scores always pick the best current score") {
+    auto rnd = prng_t{13};
+    for (uint64_t n = 0; n < 20; ++n) {
+        auto inst      = make_easy_inst(n, 500_C);
+        auto nrows     = rsize(inst.rows);
+        auto lagr_mult = std::vector<real_t>(nrows);
+        for (real_t& u : lagr_mult)
+            u = rnd_real(rnd, 0.0_F, 1.0_F);
+
+        auto score_info = Scores();
+        compute_reduced_costs(inst, lagr_mult, score_info.gammas);
+        complete_scores_init(inst, score_info);
+
+        auto   cover          = CoverCounters(nrows);
+        ridx_t nrows_to_cover = nrows;
+        while (nrows_to_cover > 0_R) {
+            auto good = min(as_cidx(nrows_to_cover), 7_C);  // Small, to exercise the refills
+            auto best = pop_best_score(score_info, good);
+
+            real_t expected = limits<real_t>::max();
+            for (cidx_t j = 0_C; j < csize(inst.cols); ++j)
+                expected = min(expected, local::current_score(score_info, j));
+            REQUIRE(best.score == expected);
+
+            update_changed_scores(inst, lagr_mult, cover, best.idx, score_info);
+            nrows_to_cover -= as_ridx(cover.cover(inst.cols[best.idx]));
+        }
+    }
+}
+
+TEST_CASE("Greedy applies the enumeration limits") {
+    auto rnd      = prng_t{7};
+    int  discards = 0;
+    for (uint64_t n = 0; n < 20; ++n) {
+        auto inst      = make_easy_inst(n, 500_C);
+        auto lagr_mult = std::vector<real_t>(rsize(inst.rows));
+        for (real_t& u : lagr_mult)
+            u = rnd_real(rnd, 0.0_F, 1.0_F);
+        auto reduced_costs = std::vector<real_t>();
+        compute_reduced_costs(inst, lagr_mult, reduced_costs);
+
+        auto   sol  = std::vector<cidx_t>();
+        real_t cost = Greedy()(inst, lagr_mult, reduced_costs, sol);
+
+        // Without nodes, a solution that needs the enumeration is discarded (cost == cutoff)
+        auto no_nodes = Greedy();
+        no_nodes.set_enum_limits(24, 0);
+        sol.clear();
+        real_t limited_cost = no_nodes(inst, lagr_mult, reduced_costs, sol);
+        CHECK((limited_cost == cost || limited_cost == limits<real_t>::max()));
+        discards += limited_cost == limits<real_t>::max() ? 1 : 0;
+    }
+    CHECK(discards > 0);
+}
+
+}  // namespace cft
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2024 Francesco Cavaliere <francescocava95@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "utils/parallel.hpp"
+#include "utils/utility.hpp"
+
+namespace cft {
+
+TEST_CASE("parallel_run: should call the function once per thread id") {
+    for (size_t nthreads : {0U, 1U, 2U, 7U}) {
+        auto calls = std::vector<int>(cft::max(nthreads, size_t{1}), 0);
+        parallel_run(nthreads, [&](size_t tid) { ++calls[tid]; });
+        CHECK(calls == std::vector<int>(calls.size(), 1));
+    }
+}
+
+TEST_CASE("parallel_run: should rethrow exceptions in the calling thread") {
+    auto work = [](size_t tid) {
+        if (tid == 2)
+            throw std::runtime_error("worker failure");
+    };
+    CHECK_THROWS_AS(parallel_run(4, work), std::runtime_error);
+    CHECK_NOTHROW(parallel_run(2, work));
+}
+
+}  // namespace cft
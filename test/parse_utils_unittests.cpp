@@ -5,6 +5,11 @@
 #define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
 #include <doctest/doctest.h>
 
+#include <fmt/ostream.h>
+
+#include <cstdio>
+#include <fstream>
+
 #include "utils/parse_utils.hpp"
 
 namespace cft {
@@ -58,6 +63,16 @@ TEST_CASE("split: should handle leading and trailing spaces") {
     CHECK(split(str) == expected);
 }
 
+TEST_CASE("consume_token: should extract whitespace-separated tokens in order") {
+    auto str  = std::string("  x10   r_000001  -1 ");
+    auto view = StringView(str);
+    CHECK(consume_token(view) == "x10");
+    CHECK(consume_token(view) == "r_000001");
+    CHECK(consume_token(view) == "-1");
+    CHECK(consume_token(view).empty());
+    CHECK(consume_token(view).empty());
+}
+
 TEST_CASE("string_to: should parse string to integral types") {
     auto str = std::string("123");
     CHECK(string_to<int>::parse(str) == 123);
@@ -72,4 +87,56 @@ TEST_CASE("string_to: should parse string to floating-point types") {
     CHECK(string_to<long double>::parse(str) == doctest::Approx(3.14L));
 }
 
+TEST_CASE("fast_string_to: should match string_to on plain numbers") {
+    auto str = std::string(" 123 -45 3.14 -0.5 .25 7");
+    auto fst = StringView(str);
+    auto ref = StringView(str);
+    CHECK(fast_string_to<int>::consume(fst) == string_to<int>::consume(ref));
+    CHECK(fast_string_to<long>::consume(fst) == string_to<long>::consume(ref));
+    CHECK(fast_string_to<double>::consume(fst) == string_to<double>::consume(ref));
+    CHECK(fast_string_to<float>::consume(fst) == string_to<float>::consume(ref));
+    CHECK(fast_string_to<double>::consume(fst) == string_to<double>::consume(ref));
+    CHECK(fast_string_to<int16_t>::consume(fst) == 7);
+    CHECK(fst.empty());
+}
+
+TEST_CASE("fast_string_to: should not read past the end of the view") {
+    auto str = std::string("12345");
+    auto sub = StringView(str).get_substr(0, 3);
+    CHECK(fast_string_to<int>::parse(sub) == 123);
+    CHECK(fast_string_to<double>::parse(sub) == doctest::Approx(123.0));
+}
+
+TEST_CASE("fast_string_to: should handle exponents and special values via fallback") {
+    CHECK(fast_string_to<double>::parse(std::string("1.5e3")) == doctest::Approx(1500.0));
+    CHECK(fast_string_to<long double>::parse(std::string("3.14")) == doctest::Approx(3.14L));
+    CHECK(fast_string_to<uint64_t>::parse(std::string("18446744073709551615")) ==
+          limits<uint64_t>::max());
+}
+
+TEST_CASE("fast_string_to: should throw on invalid or out of range input") {
+    CHECK_THROWS_AS(fast_string_to<int>::parse(std::string("")), std::invalid_argument);
+    CHECK_THROWS_AS(fast_string_to<int>::parse(std::string("  abc")), std::invalid_argument);
+    CHECK_THROWS_AS(fast_string_to<int8_t>::parse(std::string("300")), std::out_of_range);
+    CHECK_THROWS_AS(fast_string_to<int8_t>::parse(std::string("-129")), std::out_of_range);
+    CHECK_THROWS_AS(fast_string_to<double>::parse(std::string("inf")), std::out_of_range);
+}
+
+TEST_CASE("MappedLineIterator: should return trimmed lines") {
+    auto path = std::string("mapped_lines_test.txt");
+    auto file = std::ofstream(path);
+    fmt::print(file, "  first line \r\n\nlast line");
+    file.close();
+
+    auto iter = MappedLineIterator(path);
+    CHECK(iter.next() == "first line");
+    CHECK(iter.next().empty());
+    CHECK(iter.next() == "last line");
+    CHECK(iter.next().empty());
+    CHECK(iter.next().empty());
+    std::remove(path.c_str());
+
+    CHECK_THROWS_AS(MappedLineIterator("/invalid/path/file.txt"), std::invalid_argument);
+}
+
 }  // namespace cft
\ No newline at end of file
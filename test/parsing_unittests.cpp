@@ -5,7 +5,12 @@
 #define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
 #include <doctest/doctest.h>
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
 #include <stdexcept>
+#include <string>
 
 #include "core/cft.hpp"
 #include "core/parsing.hpp"
@@ -100,6 +105,213 @@ TEST_CASE("test_parse_mps_instance") {
     CHECK(abs(inst.costs[0] - 1.0_F) < 0.01_F);
 }
 
+TEST_CASE("test_mmap_parsing_matches_stream_parsing") {
+    auto check_same = [](Instance const& a, Instance const& b) {
+        CHECK(a.cols.idxs == b.cols.idxs);
+        CHECK(a.cols.begs == b.cols.begs);
+        CHECK(a.costs == b.costs);
+        CHECK(a.rows == b.rows);
+    };
+
+    check_same(parse_scp_instance("../../instances/scp/scp41.txt"),
+               parse_scp_instance("../../instances/scp/scp41.txt", MmapParsing{}));
+    check_same(parse_rail_instance("../../instances/rail/rail507"),
+               parse_rail_instance("../../instances/rail/rail507", MmapParsing{}));
+
+    auto path   = std::string("../../instances/cvrp/X-n573-k30_z51112_cplex51109.scp");
+    auto stream = parse_cvrp_instance(path);
+    auto mapped = parse_cvrp_instance(path, MmapParsing{});
+    check_same(stream.inst, mapped.inst);
+    CHECK(stream.init_sol.idxs == mapped.init_sol.idxs);
+    CHECK(stream.init_sol.cost == mapped.init_sol.cost);
+}
+
+TEST_CASE("test_parallel_parsing_matches_serial_parsing") {
+    auto check_same = [](Instance const& a, Instance const& b) {
+        CHECK(a.cols.idxs == b.cols.idxs);
+        CHECK(a.cols.begs == b.cols.begs);
+        CHECK(a.costs == b.costs);
+        CHECK(a.rows == b.rows);
+    };
+
+    auto rail_path = std::string("../../instances/rail/rail507");
+    auto cvrp_path = std::string("../../instances/cvrp/X-n573-k30_z51112_cplex51109.scp");
+    auto rail      = parse_rail_instance(rail_path);
+    auto cvrp      = parse_cvrp_instance(cvrp_path);
+    for (size_t nthreads : {1U, 2U, 3U, 8U, 64U}) {
+        check_same(rail, parse_rail_instance(rail_path, ParallelParsing(nthreads)));
+
+        auto par_cvrp = parse_cvrp_instance(cvrp_path, ParallelParsing(nthreads));
+        check_same(cvrp.inst, par_cvrp.inst);
+        CHECK(cvrp.init_sol.idxs == par_cvrp.init_sol.idxs);
+        CHECK(cvrp.init_sol.cost == par_cvrp.init_sol.cost);
+    }
+
+    CHECK_THROWS(parse_rail_instance("../../instances/scp/scp41.txt", ParallelParsing(4)));
+    CHECK_THROWS(parse_cvrp_instance("../../instances/rail/rail507", ParallelParsing(4)));
+}
+
+TEST_CASE("test_binary_instance_roundtrip") {
+    auto path = std::string("test_instance.cftb");
+
+    auto rail = FileData();
+    rail.inst = parse_rail_instance("../../instances/rail/rail507");
+    write_binary_instance(path, rail);
+    auto loaded = parse_binary_instance(path);
+    CHECK(loaded.inst.cols.idxs == rail.inst.cols.idxs);
+    CHECK(loaded.inst.cols.begs == rail.inst.cols.begs);
+    CHECK(loaded.inst.costs == rail.inst.costs);
+    CHECK(loaded.inst.rows == rail.inst.rows);
+    CHECK(loaded.init_sol.idxs.empty());
+
+    // Initial solution with a column out of range
+    rail.init_sol.idxs = {0_C, csize(rail.inst.cols)};
+    write_binary_instance(path, rail);
+    CHECK_THROWS_AS(parse_binary_instance(path), std::invalid_argument);
+
+    auto cvrp = parse_cvrp_instance("../../instances/cvrp/X-n573-k30_z51112_cplex51109.scp");
+    write_binary_instance(path, cvrp);
+    loaded = parse_binary_instance(path);
+    CHECK(loaded.inst.cols.idxs == cvrp.inst.cols.idxs);
+    CHECK(loaded.inst.rows == cvrp.inst.rows);
+    CHECK(loaded.init_sol.idxs == cvrp.init_sol.idxs);
+    CHECK(loaded.init_sol.cost == cvrp.init_sol.cost);
+
+    auto env      = Environment();
+    env.parser    = CFT_BINARY_PARSER;
+    env.inst_path = path;
+    CHECK(parse_inst_and_initsol(env).inst.costs == cvrp.inst.costs);
+
+    // Truncated file
+    auto bytes = std::string();
+    {
+        auto in = std::ifstream(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        auto out = std::ofstream(path, std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2));
+    }
+    CHECK_THROWS_AS(parse_binary_instance(path), std::invalid_argument);
+    std::remove(path.c_str());
+
+    CHECK_THROWS_AS(parse_binary_instance("../../instances/scp/scp41.txt"), std::invalid_argument);
+    CHECK_THROWS(parse_binary_instance("../../instances/missing.cftb"));
+}
+
+TEST_CASE("test_checkpoint_roundtrip") {
+    auto path = std::string("test_checkpoint.cftk");
+    auto inst = parse_scp_instance("../../instances/scp/scp41.txt");
+
+    auto ckpt = CftResult();
+    ckpt.sol  = Solution{{}, 0.0_F};
+    for (cidx_t j = 0_C; j < csize(inst.cols); ++j)  // Trivially feasible
+        ckpt.sol.idxs.push_back(j);
+    ckpt.sol.cost       = 1.0_F;  // Wrong on purpose, fit_checkpoint recomputes it
+    ckpt.dual.mults     = std::vector<real_t>(rsize(inst.rows), 0.5_F);
+    ckpt.dual.lb        = 123.0_F;
+    ckpt.dual.core_cols = {3_C, 1_C, csize(inst.cols)};
+    ckpt.dual.step_size = 0.01_F;
+    write_checkpoint(path, ckpt);
+
+    auto loaded = parse_checkpoint(path);
+    CHECK(loaded.sol.idxs == ckpt.sol.idxs);
+    CHECK(loaded.sol.cost == ckpt.sol.cost);
+    CHECK(loaded.dual.mults == ckpt.dual.mults);
+    CHECK(loaded.dual.lb == ckpt.dual.lb);
+    CHECK(loaded.dual.core_cols == ckpt.dual.core_cols);
+    CHECK(loaded.dual.step_size == ckpt.dual.step_size);
+
+    fit_checkpoint(inst, loaded);
+    real_t tot_cost = 0.0_F;
+    for (real_t c : inst.costs)
+        tot_cost += c;
+    CHECK(loaded.sol.cost == tot_cost);
+    CHECK(loaded.dual.mults == ckpt.dual.mults);
+    CHECK(loaded.dual.core_cols == std::vector<cidx_t>{3_C, 1_C});  // Out of range one dropped
+
+    // Checkpoint of a different instance: only the valid core columns survive
+    auto other = parse_rail_instance("../../instances/rail/rail507");
+    loaded     = parse_checkpoint(path);
+    fit_checkpoint(other, loaded);
+    CHECK(loaded.sol.idxs.empty());
+    CHECK(loaded.dual.mults.empty());
+
+    real_t const nan = std::numeric_limits<real_t>::quiet_NaN();
+    for (real_t step_size : {0.0_F, -0.01_F, limits<real_t>::inf(), nan}) {
+        ckpt.dual.step_size = step_size;
+        write_checkpoint(path, ckpt);
+        CHECK_THROWS_AS(parse_checkpoint(path), std::invalid_argument);
+    }
+    ckpt.dual.mults.clear();  // No dual, the step size is not used
+    write_checkpoint(path, ckpt);
+    CHECK_NOTHROW(parse_checkpoint(path));
+
+    ckpt.dual.mults     = std::vector<real_t>(rsize(inst.rows), 0.5_F);
+    ckpt.dual.step_size = 0.01_F;
+    ckpt.dual.mults[0]  = -1.0_F;
+    write_checkpoint(path, ckpt);
+    CHECK_THROWS_AS(parse_checkpoint(path), std::invalid_argument);
+    std::remove(path.c_str());
+
+    CHECK_THROWS_AS(parse_checkpoint("../../instances/scp/scp41.txt"), std::invalid_argument);
+}
+
+TEST_CASE("test_instance_too_large_for_index_types") {
+    auto path = std::string("test_large_instance.txt");
+    {
+        auto out = std::ofstream(path);
+        out << "40000 1\n1 1 40000\n";
+    }
+    if (sizeof(ridx_t) < 4) {
+        CHECK_THROWS_AS(parse_rail_instance(path), RowIndexOverflow);
+        CHECK_THROWS_AS(parse_rail_instance(path, MmapParsing{}), RowIndexOverflow);
+        CHECK_THROWS_AS(parse_scp_instance(path), RowIndexOverflow);
+    } else {
+        CHECK(rsize(parse_rail_instance(path).rows) == 40000_R);
+    }
+    {
+        auto out = std::ofstream(path);
+        out << "40000 3000000000\n";
+    }
+    // Too many columns as well: not a row overflow, wider row indexes would not help
+    auto is_row_overflow = false;
+    try {
+        parse_rail_instance(path);
+    } catch (RowIndexOverflow const&) {
+        is_row_overflow = true;
+    } catch (IndexOverflow const&) {
+    }
+    CHECK_FALSE(is_row_overflow);
+    CHECK_THROWS_AS(parse_rail_instance(path), IndexOverflow);
+    {
+        auto out = std::ofstream(path);
+        out << "-1 1\n1 1 1\n";
+    }
+    CHECK_THROWS_AS(parse_rail_instance(path), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("test_mps_parsing_modes") {
+    auto stream = parse_mps_instance("../../instances/mps/ramos3.mps");
+    auto mapped = parse_mps_instance("../../instances/mps/ramos3.mps", MmapParsing{});
+    CHECK(stream.cols.idxs == mapped.cols.idxs);
+    CHECK(stream.cols.begs == mapped.cols.begs);
+    CHECK(stream.costs == mapped.costs);
+    CHECK(stream.rows == mapped.rows);
+}
+
+TEST_CASE("test wrong parser with mmap parsing") {
+    auto mode = MmapParsing{};
+    CHECK_THROWS(parse_scp_instance("../../instances/rail/rail507", mode));
+    CHECK_THROWS(parse_scp_instance("../../instances/mps/ramos3.mps", mode));
+    CHECK_THROWS(parse_rail_instance("../../instances/scp/scp41.txt", mode));
+    CHECK_THROWS(parse_rail_instance("../../instances/mps/ramos3.mps", mode));
+    CHECK_THROWS(parse_cvrp_instance("../../instances/scp/scp41.txt", mode));
+    CHECK_THROWS(parse_cvrp_instance("../../instances/rail/rail507", mode));
+    CHECK_THROWS(parse_scp_instance("../../instances/src/main.cpp", mode));
+}
+
 TEST_CASE("test wrong parser") {
     CHECK_THROWS(parse_scp_instance("../../instances/rail/rail507"));
     CHECK_THROWS(parse_scp_instance("../../instances/cvrp/X-n536-k96_z95480_cplex95479.scp"));
@@ -55,5 +55,57 @@ TEST_CASE("enumeration_removal removes redundant columns using implicit enumerat
     }
 }
 
+TEST_CASE("enumeration_removal finds the cheapest non-redundant subset") {
+    auto rnd     = prng_t(1);
+    int  nchecks = 0;
+    for (uint64_t n = 0; n < 200; ++n) {
+        auto inst = make_easy_inst(n, 100_C);
+
+        auto sol = std::vector<cidx_t>{0_C, 1_C, 2_C, 3_C, 4_C, 5_C, 6_C, 7_C, 8_C, 9_C};
+        for (cidx_t j = 10_C; j < csize(inst.cols); ++j)
+            if (roll_dice(rnd, 0, 3) == 0)
+                sol.push_back(j);
+
+        auto red_set = RedundancyData();
+        red_set.total_cover.reset(rsize(inst.rows));
+        for (cidx_t j : sol)
+            red_set.total_cover.cover(inst.cols[j]);
+        complete_init_redund_set(inst, sol, limits<real_t>::max(), red_set);
+        cidx_t nredund = csize(red_set.redund_set);
+        if (nredund == 0_C || nredund > 16_C)
+            continue;
+
+        // Brute force over the subsets of redundant columns to keep
+        real_t best_cost = limits<real_t>::max();
+        for (uint64_t keep = 0; keep < (uint64_t{1} << native_cast(nredund)); ++keep) {
+            auto   cover = red_set.partial_cover;
+            real_t cost  = red_set.partial_cost;
+            ridx_t ncov  = red_set.partial_cov_count;
+            for (cidx_t r = 0_C; r < nredund; ++r)
+                if ((keep & (uint64_t{1} << native_cast(r))) != 0) {
+                    ncov += as_ridx(cover.cover(inst.cols[red_set.redund_set[r].idx]));
+                    cost += red_set.redund_set[r].cost;
+                }
+            if (ncov == rsize(inst.rows))
+                best_cost = min(best_cost, cost);
+        }
+
+        red_set.max_enum_nodes = limits<uint64_t>::max();
+        enumeration_removal(inst, red_set);
+        CHECK(red_set.best_cost == best_cost);
+
+        // Without a cutoff no branch is pruned by cost, so a tiny node budget still completes the
+        // first dive (with a cutoff it could dead-end and find nothing)
+        auto small_budget           = RedundancyData();
+        small_budget.total_cover    = red_set.total_cover;
+        small_budget.max_enum_nodes = checked_cast<uint64_t>(nredund) + 1U;
+        complete_init_redund_set(inst, sol, limits<real_t>::max(), small_budget);
+        enumeration_removal(inst, small_budget);
+        CHECK(small_budget.best_cost < limits<real_t>::max());
+        CHECK(small_budget.best_cost >= best_cost);
+        ++nchecks;
+    }
+    CHECK(nchecks > 50);
+}
 
 }  // namespace cft
@@ -82,3 +82,31 @@ def test_simple_incremental_new_element():
     solver.solve()
     solution = solver.get_solution()
     assert solver.get_cost() == 15, "Objective value is not 15"
+
+
+def test_incumbent_callback():
+    solver = pycft.SetCoverSolver()
+    solver.add_set([0, 1, 2, 3, 4, 5, 6, 7, 8, 9], cost=10)
+    solver.add_set([0, 1, 2, 3, 4, 5], cost=5)
+    solver.add_set([0, 1, 2, 3, 4], cost=4)
+    solver.add_set([6, 7, 8, 9], cost=4)
+    costs = []
+    solver.solve(on_incumbent=lambda sol, cost, lb, time: costs.append(cost))
+    assert costs, "No solution streamed"
+    assert costs == sorted(costs, reverse=True), "Streamed solutions do not improve"
+    assert costs[-1] == solver.get_cost(), "Last streamed solution is not the returned one"
+
+
+def test_stop_from_another_thread():
+    import threading
+
+    solver = pycft.SetCoverSolver()
+    solver.add_set([0, 1, 2, 3, 4, 5, 6, 7, 8, 9], cost=10)
+    solver.add_set([0, 1, 2, 3, 4, 5], cost=5)
+    solver.add_set([0, 1, 2, 3, 4], cost=4)
+    solver.add_set([6, 7, 8, 9], cost=4)
+    stopper = threading.Timer(0.01, solver.stop)
+    stopper.start()
+    solver.solve()
+    stopper.join()
+    assert solver.get_solution() is not None, "No solution kept after stopping"